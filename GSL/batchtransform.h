@@ -0,0 +1,42 @@
+#ifndef BATCHTRANSFORM_H
+#define BATCHTRANSFORM_H
+
+#include "gltypes.h"
+#include <cstddef>
+#include <vector>
+
+namespace gsl
+{
+class Matrix4x4;
+class Vector3D;
+class Vector4D;
+
+    //Transform many points/vectors with one matrix. in and out may be the same array.
+    //Inputs of 262144 elements or more are split into chunks and done on several threads,
+    //which are started for each call. Smaller ones run on the calling thread only,
+    //so per frame work should be gathered into as few calls as possible.
+    //The matrix is assumed affine for points and vectors, so there is no divide by w.
+
+    //Positions: uses w = 1, so translation is applied
+    void transformPoints(const Matrix4x4 &matrix, const Vector3D *in, Vector3D *out, std::size_t count);
+    //Directions: uses w = 0, so translation is ignored
+    void transformVectors(const Matrix4x4 &matrix, const Vector3D *in, Vector3D *out, std::size_t count);
+    //Normals: uses the inverse transpose of the matrix and normalizes the result,
+    //so non-uniform scale does not skew them.
+    //Returns false if the matrix has no inverse (ex. scaled to 0 on one axis) - out is then a copy of in.
+    bool transformNormals(const Matrix4x4 &matrix, const Vector3D *in, Vector3D *out, std::size_t count);
+    //Full 4D multiply, w included
+    void transform(const Matrix4x4 &matrix, const Vector4D *in, Vector4D *out, std::size_t count);
+
+    //Points stored with a stride, ex. the positions inside an array of Vertex.
+    //Strides are counted in GLfloats, not bytes.
+    void transformPoints(const Matrix4x4 &matrix, const GLfloat *in, std::size_t inStride,
+                         GLfloat *out, std::size_t outStride, std::size_t count);
+
+    //In place versions for whole vectors
+    void transformPoints(const Matrix4x4 &matrix, std::vector<Vector3D> &points);
+    bool transformNormals(const Matrix4x4 &matrix, std::vector<Vector3D> &normals);
+
+} //namespace
+
+#endif // BATCHTRANSFORM_H
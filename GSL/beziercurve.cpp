@@ -0,0 +1,225 @@
+#include "beziercurve.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace gsl
+{
+    namespace
+    {
+        //Forward differencing keeps its running differences on the stack in double precision,
+        //float drifts too much over long runs. Higher degrees fall back to Horner per sample.
+        constexpr std::size_t MaxForwardDifferenceDegree = 8;
+
+        using Differences = std::array<std::array<double, 3>, MaxForwardDifferenceDegree + 1>;
+
+        //One step: every difference takes in the one of the order above it.
+        //Unrolled with a fold, so the compiler can keep all of them in registers.
+        template <std::size_t Degree, std::size_t... Orders>
+        inline void addDifferences(std::array<std::array<double, 3>, Degree + 1> &differences, std::index_sequence<Orders...>)
+        {
+            ((differences[Orders][0] += differences[Orders + 1][0],
+              differences[Orders][1] += differences[Orders + 1][1],
+              differences[Orders][2] += differences[Orders + 1][2]), ...);
+        }
+
+        //The stepping loop, with the degree known at compile time
+        template <std::size_t Degree>
+        void stepForwardDifferences(const Differences &start, Vector3D *out, std::size_t count)
+        {
+            std::array<std::array<double, 3>, Degree + 1> differences;
+            for (std::size_t k = 0; k <= Degree; k++)
+                differences[k] = start[k];
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[i] = Vector3D(static_cast<GLfloat>(differences[0][0]),
+                                  static_cast<GLfloat>(differences[0][1]),
+                                  static_cast<GLfloat>(differences[0][2]));
+                addDifferences<Degree>(differences, std::make_index_sequence<Degree>{});
+            }
+        }
+
+        using StepFunction = void (*)(const Differences &, Vector3D *, std::size_t);
+
+        template <std::size_t... Degrees>
+        constexpr std::array<StepFunction, sizeof...(Degrees)> makeStepFunctions(std::index_sequence<Degrees...>)
+        {
+            return {{&stepForwardDifferences<Degrees>...}};
+        }
+
+        constexpr auto stepFunctions = makeStepFunctions(std::make_index_sequence<MaxForwardDifferenceDegree + 1>{});
+    }
+
+    BezierCurve::BezierCurve(const std::vector<Vector3D> &controlPoints)
+    {
+        setControlPoints(controlPoints);
+    }
+
+    void BezierCurve::setControlPoints(const std::vector<Vector3D> &controlPoints)
+    {
+        mControlPoints = controlPoints;
+        mArcLengths.clear();
+        mCoefficients.assign(mControlPoints.size(), std::array<double, 3>{});
+
+        if (mControlPoints.empty())
+            return;
+
+        //c_k = C(n, k) * sum over i <= k of (-1)^(k - i) * C(k, i) * P_i
+        std::size_t n = degree();
+        double binomialNK = 1.0;    //C(n, k)
+        for (std::size_t k = 0; k <= n; k++)
+        {
+            double binomialKI = 1.0;    //C(k, i)
+            for (std::size_t i = 0; i <= k; i++)
+            {
+                double weight = binomialNK * (((k - i) % 2 == 0) ? binomialKI : -binomialKI);
+                mCoefficients[k][0] += weight * mControlPoints[i].x;
+                mCoefficients[k][1] += weight * mControlPoints[i].y;
+                mCoefficients[k][2] += weight * mControlPoints[i].z;
+                binomialKI = binomialKI * (k - i) / (i + 1);
+            }
+            binomialNK = binomialNK * (n - k) / (k + 1);
+        }
+    }
+
+    std::size_t BezierCurve::degree() const
+    {
+        return mControlPoints.empty() ? 0 : mControlPoints.size() - 1;
+    }
+
+    Vector3D BezierCurve::evaluate(GLfloat t) const
+    {
+        if (mCoefficients.empty())
+            return Vector3D{};
+
+        double x{0.0}, y{0.0}, z{0.0};
+        for (std::size_t k = mCoefficients.size(); k-- > 0;)
+        {
+            x = x * t + mCoefficients[k][0];
+            y = y * t + mCoefficients[k][1];
+            z = z * t + mCoefficients[k][2];
+        }
+
+        return Vector3D(static_cast<GLfloat>(x), static_cast<GLfloat>(y), static_cast<GLfloat>(z));
+    }
+
+    Vector3D BezierCurve::tangent(GLfloat t) const
+    {
+        if (mCoefficients.size() < 2)
+            return Vector3D{};
+
+        double x{0.0}, y{0.0}, z{0.0};
+        for (std::size_t k = mCoefficients.size() - 1; k > 0; k--)
+        {
+            x = x * t + k * mCoefficients[k][0];
+            y = y * t + k * mCoefficients[k][1];
+            z = z * t + k * mCoefficients[k][2];
+        }
+
+        return Vector3D(static_cast<GLfloat>(x), static_cast<GLfloat>(y), static_cast<GLfloat>(z));
+    }
+
+    void BezierCurve::evaluate(const GLfloat *t, Vector3D *out, std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; i++)
+            out[i] = evaluate(t[i]);
+    }
+
+    void BezierCurve::sampleUniform(Vector3D *out, std::size_t count) const
+    {
+        if (count == 0)
+            return;
+        if (count == 1 || mCoefficients.empty())
+        {
+            for (std::size_t i = 0; i < count; i++)
+                out[i] = evaluate(0.f);
+            return;
+        }
+
+        std::size_t n = degree();
+        double step = 1.0 / static_cast<double>(count - 1);
+
+        if (n > MaxForwardDifferenceDegree)
+        {
+            for (std::size_t i = 0; i < count; i++)
+                out[i] = evaluate(static_cast<GLfloat>(i * step));
+            return;
+        }
+
+        //The differences of order j at t = 0 are calculated straight from the coefficients:
+        //the j-th difference of t^k with step h is h^k * j! * S(k, j), S being Stirling numbers of the second kind.
+        //Taking them from sampled values instead loses too many digits to the subtractions.
+        //The n-th difference of a degree n polynomial is constant, so stepping is just n additions.
+        std::array<std::array<double, MaxForwardDifferenceDegree + 1>, MaxForwardDifferenceDegree + 1> stirling{};
+        stirling[0][0] = 1.0;
+        for (std::size_t k = 1; k <= n; k++)
+        {
+            for (std::size_t j = 1; j <= k; j++)
+                stirling[k][j] = j * stirling[k - 1][j] + stirling[k - 1][j - 1];
+        }
+
+        Differences differences{};
+        double jFactorial = 1.0;
+        for (std::size_t j = 0; j <= n; j++)
+        {
+            if (j > 0)
+                jFactorial *= j;
+
+            double stepPower = 1.0;     //h^k
+            for (std::size_t k = 0; k <= n; k++)
+            {
+                double weight = stepPower * jFactorial * stirling[k][j];
+                for (std::size_t axis = 0; axis < 3; axis++)
+                    differences[j][axis] += weight * mCoefficients[k][axis];
+                stepPower *= step;
+            }
+        }
+
+        stepFunctions[n](differences, out, count);
+
+        //Land exactly on the last control point
+        out[count - 1] = mControlPoints.back();
+    }
+
+    void BezierCurve::buildArcLengthTable(std::size_t segments)
+    {
+        segments = std::max<std::size_t>(segments, 1);
+
+        std::vector<Vector3D> samples(segments + 1);
+        sampleUniform(samples.data(), samples.size());
+
+        mArcLengths.resize(segments + 1);
+        mArcLengths[0] = 0.f;
+        for (std::size_t i = 1; i <= segments; i++)
+            mArcLengths[i] = mArcLengths[i - 1] + (samples[i] - samples[i - 1]).length();
+    }
+
+    GLfloat BezierCurve::length() const
+    {
+        return mArcLengths.empty() ? 0.f : mArcLengths.back();
+    }
+
+    GLfloat BezierCurve::parameterAtDistance(GLfloat distance) const
+    {
+        if (mArcLengths.size() < 2 || distance <= 0.f)
+            return 0.f;
+        if (distance >= mArcLengths.back())
+            return 1.f;
+
+        //First entry past distance - the answer lies in the segment before it
+        auto upper = std::upper_bound(mArcLengths.begin(), mArcLengths.end(), distance);
+        std::size_t segment = static_cast<std::size_t>(upper - mArcLengths.begin()) - 1;
+
+        GLfloat segmentStart = mArcLengths[segment];
+        GLfloat segmentLength = mArcLengths[segment + 1] - segmentStart;
+        GLfloat fraction = segmentLength > 0.f ? (distance - segmentStart) / segmentLength : 0.f;
+
+        return (static_cast<GLfloat>(segment) + fraction) / static_cast<GLfloat>(mArcLengths.size() - 1);
+    }
+
+    Vector3D BezierCurve::pointAtDistance(GLfloat distance) const
+    {
+        return evaluate(parameterAtDistance(distance));
+    }
+} //namespace
@@ -0,0 +1,60 @@
+#ifndef BEZIERCURVE_H
+#define BEZIERCURVE_H
+
+#include "vector3d.h"
+#include "gltypes.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace gsl
+{
+
+//A bezier curve of any degree (number of control points - 1).
+//The control points are turned into power basis coefficients once, so evaluating is a
+//Horner loop with no copying or allocation. Made for sampling the same curve many times,
+//ex. AI boats following a route. For a one-off point gsl::bezierCurve still works.
+class BezierCurve
+{
+public:
+    BezierCurve() = default;
+    explicit BezierCurve(const std::vector<Vector3D> &controlPoints);
+
+    //Recalculates the coefficients and clears the arc length table
+    void setControlPoints(const std::vector<Vector3D> &controlPoints);
+    const std::vector<Vector3D> &controlPoints() const { return mControlPoints; }
+    std::size_t degree() const;
+
+    //Input t from 0 to 1
+    Vector3D evaluate(GLfloat t) const;
+    //Derivative with respect to t - the direction of travel, not normalized
+    Vector3D tangent(GLfloat t) const;
+
+    //Evaluates count parameter values in one go. out must have room for count points.
+    void evaluate(const GLfloat *t, Vector3D *out, std::size_t count) const;
+    //count evenly spaced points from t = 0 to t = 1, both included, using forward differencing:
+    //after the setup each point costs degree additions instead of a full polynomial.
+    void sampleUniform(Vector3D *out, std::size_t count) const;
+
+    //Arc length - needed to move along the curve at constant speed, since t does not map linearly to distance.
+    //The table stores the length at segments + 1 evenly spaced values of t, measured along straight chords.
+    void buildArcLengthTable(std::size_t segments = 64);
+    bool hasArcLengthTable() const { return !mArcLengths.empty(); }
+    //Total length of the curve. Needs the arc length table.
+    GLfloat length() const;
+    //The t that lies distance units along the curve, clamped to 0 - length(). Needs the arc length table.
+    GLfloat parameterAtDistance(GLfloat distance) const;
+    Vector3D pointAtDistance(GLfloat distance) const;
+
+private:
+    std::vector<Vector3D> mControlPoints;
+    //Power basis: P(t) = mCoefficients[0] + mCoefficients[1] * t + mCoefficients[2] * t^2 ...
+    //Kept in double, the power basis cancels badly in float for higher degrees
+    std::vector<std::array<double, 3>> mCoefficients;
+    //Accumulated length at t = i / (mArcLengths.size() - 1)
+    std::vector<GLfloat> mArcLengths;
+};
+
+} //namespace
+
+#endif // BEZIERCURVE_H
@@ -0,0 +1,188 @@
+#include "bsplinecurve.h"
+#include <algorithm>
+#include <array>
+#include <QDebug>
+
+namespace gsl
+{
+    BSplineCurve::BSplineCurve(const std::vector<Vector3D> &controlPoints, const std::vector<GLfloat> &knots, std::size_t degree)
+    {
+        set(controlPoints, knots, degree);
+    }
+
+    BSplineCurve::BSplineCurve(const std::vector<Vector3D> &controlPoints, std::size_t degree)
+    {
+        setClampedUniform(controlPoints, degree);
+    }
+
+    void BSplineCurve::set(const std::vector<Vector3D> &controlPoints, const std::vector<GLfloat> &knots, std::size_t degree)
+    {
+        mControlPoints = controlPoints;
+        mKnots = knots;
+        mDegree = degree;
+        validate();
+    }
+
+    void BSplineCurve::setClampedUniform(const std::vector<Vector3D> &controlPoints, std::size_t degree)
+    {
+        mControlPoints = controlPoints;
+        mDegree = degree;
+        mKnots.clear();
+
+        std::size_t n = mControlPoints.size();
+        if (n > degree)
+        {
+            //degree + 1 zeros, evenly spaced inner knots, degree + 1 ones
+            std::size_t innerSpans = n - degree;
+            mKnots.reserve(n + degree + 1);
+            for (std::size_t i = 0; i < degree; i++)
+                mKnots.push_back(0.f);
+            for (std::size_t i = 0; i <= innerSpans; i++)
+                mKnots.push_back(static_cast<GLfloat>(i) / static_cast<GLfloat>(innerSpans));
+            for (std::size_t i = 0; i < degree; i++)
+                mKnots.push_back(1.f);
+        }
+        validate();
+    }
+
+    void BSplineCurve::validate()
+    {
+        mValid = false;
+
+        if (mDegree > MaxDegree)
+        {
+            qDebug() << "BSplineCurve: degree" << mDegree << "is above the max of" << MaxDegree;
+            return;
+        }
+        if (mControlPoints.size() <= mDegree)
+        {
+            qDebug() << "BSplineCurve: a degree" << mDegree << "curve needs at least" << mDegree + 1 << "control points";
+            return;
+        }
+        if (mKnots.size() != mControlPoints.size() + mDegree + 1)
+        {
+            qDebug() << "BSplineCurve: expected" << mControlPoints.size() + mDegree + 1 << "knots, got" << mKnots.size();
+            return;
+        }
+        if (!std::is_sorted(mKnots.begin(), mKnots.end()))
+        {
+            qDebug() << "BSplineCurve: knots must be in increasing order";
+            return;
+        }
+
+        mValid = true;
+    }
+
+    GLfloat BSplineCurve::startParameter() const
+    {
+        return mValid ? mKnots[mDegree] : 0.f;
+    }
+
+    GLfloat BSplineCurve::endParameter() const
+    {
+        return mValid ? mKnots[mControlPoints.size()] : 0.f;
+    }
+
+    std::size_t BSplineCurve::findSpan(GLfloat x) const
+    {
+        std::size_t last = mControlPoints.size() - 1;
+
+        //The end of the range belongs to the last span
+        if (x >= mKnots[last + 1])
+            return last;
+        if (x <= mKnots[mDegree])
+            return mDegree;
+
+        //First knot above x, among knots[degree + 1] - knots[last + 1]. The span starts one before it.
+        auto upper = std::upper_bound(mKnots.begin() + static_cast<std::ptrdiff_t>(mDegree) + 1,
+                                      mKnots.begin() + static_cast<std::ptrdiff_t>(last) + 1, x);
+        return static_cast<std::size_t>(upper - mKnots.begin()) - 1;
+    }
+
+    std::size_t BSplineCurve::findSpan(GLfloat x, std::size_t spanHint) const
+    {
+        std::size_t last = mControlPoints.size() - 1;
+
+        if (spanHint < mDegree || spanHint > last || x < mKnots[spanHint])
+            return findSpan(x);
+
+        //Moving forward - usually still in the same span, or the next one
+        while (spanHint < last && x >= mKnots[spanHint + 1])
+            spanHint++;
+
+        return spanHint;
+    }
+
+    Vector3D BSplineCurve::evaluateInSpan(GLfloat x, std::size_t span) const
+    {
+        //Cox - de Boor, building the degree + 1 nonzero basis functions of the span bottom up
+        std::array<GLfloat, MaxDegree + 1> basis{};
+        std::array<GLfloat, MaxDegree + 1> left{};
+        std::array<GLfloat, MaxDegree + 1> right{};
+
+        basis[0] = 1.f;
+        for (std::size_t j = 1; j <= mDegree; j++)
+        {
+            left[j] = x - mKnots[span + 1 - j];
+            right[j] = mKnots[span + j] - x;
+
+            GLfloat saved = 0.f;
+            for (std::size_t r = 0; r < j; r++)
+            {
+                GLfloat denominator = right[r + 1] + left[j - r];
+                GLfloat temp = denominator != 0.f ? basis[r] / denominator : 0.f;
+                basis[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            basis[j] = saved;
+        }
+
+        //Only control points span - degree to span are affected
+        Vector3D result;
+        std::size_t first = span - mDegree;
+        for (std::size_t i = 0; i <= mDegree; i++)
+            result += mControlPoints[first + i] * basis[i];
+
+        return result;
+    }
+
+    Vector3D BSplineCurve::evaluate(GLfloat x) const
+    {
+        if (!mValid)
+            return Vector3D{};
+
+        x = std::min(std::max(x, startParameter()), endParameter());
+        return evaluateInSpan(x, findSpan(x));
+    }
+
+    Vector3D BSplineCurve::evaluate(GLfloat x, std::size_t &spanHint) const
+    {
+        if (!mValid)
+            return Vector3D{};
+
+        x = std::min(std::max(x, startParameter()), endParameter());
+        spanHint = findSpan(x, spanHint);
+        return evaluateInSpan(x, spanHint);
+    }
+
+    void BSplineCurve::evaluate(const GLfloat *x, Vector3D *out, std::size_t count) const
+    {
+        std::size_t span = mDegree;
+        for (std::size_t i = 0; i < count; i++)
+            out[i] = evaluate(x[i], span);
+    }
+
+    void BSplineCurve::sampleUniform(Vector3D *out, std::size_t count) const
+    {
+        if (count == 0)
+            return;
+
+        GLfloat start = startParameter();
+        GLfloat range = endParameter() - start;
+        GLfloat step = count > 1 ? range / static_cast<GLfloat>(count - 1) : 0.f;
+
+        std::size_t span = mDegree;
+        for (std::size_t i = 0; i < count; i++)
+            out[i] = evaluate(start + step * static_cast<GLfloat>(i), span);
+    }
+} //namespace
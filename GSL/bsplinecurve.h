@@ -0,0 +1,68 @@
+#ifndef BSPLINECURVE_H
+#define BSPLINECURVE_H
+
+#include "vector3d.h"
+#include "gltypes.h"
+#include <cstddef>
+#include <vector>
+
+namespace gsl
+{
+
+//A basis spline curve that owns its control points and knot vector.
+//Spans are found by binary search, or by stepping from the previous span when x only grows,
+//and the basis functions are calculated in a fixed size buffer on the stack, so evaluating never allocates.
+//Made for sampling the same curve many times - for a one-off point gsl::bSpline still works.
+class BSplineCurve
+{
+public:
+    //Size of the stack buffers for the basis functions
+    static constexpr std::size_t MaxDegree = 7;
+
+    BSplineCurve() = default;
+    //knots must be sorted and have controlPoints.size() + degree + 1 values
+    BSplineCurve(const std::vector<Vector3D> &controlPoints, const std::vector<GLfloat> &knots, std::size_t degree = 3);
+    //Clamped, uniform knots from 0 to 1 - the curve starts at the first and ends at the last control point
+    explicit BSplineCurve(const std::vector<Vector3D> &controlPoints, std::size_t degree = 3);
+
+    void set(const std::vector<Vector3D> &controlPoints, const std::vector<GLfloat> &knots, std::size_t degree = 3);
+    void setClampedUniform(const std::vector<Vector3D> &controlPoints, std::size_t degree = 3);
+
+    const std::vector<Vector3D> &controlPoints() const { return mControlPoints; }
+    const std::vector<GLfloat> &knots() const { return mKnots; }
+    std::size_t degree() const { return mDegree; }
+    //False if the knots don't match the control points and degree, or the degree is above MaxDegree
+    bool isValid() const { return mValid; }
+
+    //The range x can move in: knots[degree] to knots[controlPoints.size()]
+    GLfloat startParameter() const;
+    GLfloat endParameter() const;
+
+    //x is clamped to the valid range
+    Vector3D evaluate(GLfloat x) const;
+    //Same, but starts the span search at spanHint and writes the span it found back.
+    //Keep one hint per object moving along the curve - when x grows a little each frame, the search is one compare.
+    Vector3D evaluate(GLfloat x, std::size_t &spanHint) const;
+
+    //Evaluates count values of x. Sorted (increasing) input is fastest, since each span lookup
+    //then starts where the last one ended. out must have room for count points.
+    void evaluate(const GLfloat *x, Vector3D *out, std::size_t count) const;
+    //count evenly spaced points from startParameter() to endParameter(), both included
+    void sampleUniform(Vector3D *out, std::size_t count) const;
+
+private:
+    //Index of the knot span [knots[span], knots[span + 1]) that x lies in, clamped to degree - controlPoints.size() - 1
+    std::size_t findSpan(GLfloat x) const;
+    std::size_t findSpan(GLfloat x, std::size_t spanHint) const;
+    Vector3D evaluateInSpan(GLfloat x, std::size_t span) const;
+    void validate();
+
+    std::vector<Vector3D> mControlPoints;
+    std::vector<GLfloat> mKnots;
+    std::size_t mDegree{3};
+    bool mValid{false};
+};
+
+} //namespace
+
+#endif // BSPLINECURVE_H
@@ -0,0 +1,111 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include "gltypes.h"
+#include "math_constants.h"
+#include "gsl_simd.h"
+#include <cmath>
+#include <cstddef>
+
+namespace gsl
+{
+namespace fast
+{
+    //Polynomial sine and cosine, calculated together from one range reduction.
+    //The polynomials are the single precision ones from the Cephes library (sinf/cosf),
+    //evaluated on [-PI/4, PI/4] after reducing the angle by a multiple of PI/2.
+    //
+    //Error, measured against double precision std::sin/std::cos:
+    //  |radians| <= 8192:      max absolute error 8e-8 (about 1 ulp near 1)
+    //  |radians| <= 100000:    max absolute error 1e-6 (the reduction runs out of bits)
+    //  sincosDegrees:          max absolute error 8e-8 for any angle below 2^24 / 90 degrees
+    //Beyond 2^22 * PI / 2 the quadrant can't be found at all - keep angles wrapped.
+    //The SIMD bulk kernel does the same operations in the same order, so results are bit-exact between them.
+    //Don't build with -ffast-math: it may remove the rounding trick below.
+
+    //PI/2 split in three parts for the Cody-Waite reduction. The first two have few enough bits
+    //that quadrant * part is exact in float.
+    constexpr GLfloat PiOver2Part1 = 1.5703125f;
+    constexpr GLfloat PiOver2Part2 = 4.837512969970703125e-4f;
+    constexpr GLfloat PiOver2Part3 = 7.54978995489188216e-8f;
+    constexpr GLfloat TwoOverPi = 0.636619772367581343f;
+
+    //Adding and subtracting 1.5 * 2^23 rounds a float to the nearest integer (ties to even),
+    //the same as the SSE float to int conversion
+    constexpr GLfloat RoundingConstant = 12582912.f;
+
+    constexpr GLfloat SinCoefficient1 = -1.6666654611e-1f;
+    constexpr GLfloat SinCoefficient2 = 8.3321608736e-3f;
+    constexpr GLfloat SinCoefficient3 = -1.9515295891e-4f;
+    constexpr GLfloat CosCoefficient1 = 4.166664568298827e-2f;
+    constexpr GLfloat CosCoefficient2 = -1.388731625493765e-3f;
+    constexpr GLfloat CosCoefficient3 = 2.443315711809948e-5f;
+
+    //r in [-PI/4, PI/4], the result is rotated by quadrant * 90 degrees
+    inline void sincosReduced(GLfloat r, int quadrant, GLfloat &sine, GLfloat &cosine)
+    {
+        GLfloat r2 = r * r;
+
+        GLfloat s = SinCoefficient3 * r2 + SinCoefficient2;
+        s = s * r2 + SinCoefficient1;
+        s = s * r2 * r + r;
+
+        GLfloat c = CosCoefficient3 * r2 + CosCoefficient2;
+        c = c * r2 + CosCoefficient1;
+        c = c * r2 * r2 - 0.5f * r2;
+        c = c + 1.f;
+
+        //Quadrant bit 0 swaps sine and cosine, bit 1 flips the sign of the sine and bit 1 of
+        //quadrant + 1 the sign of the cosine. Written as selects so it compiles without branches.
+        bool swap = (quadrant & 1) != 0;
+        GLfloat swappedSine = swap ? c : s;
+        GLfloat swappedCosine = swap ? s : c;
+        sine = (quadrant & 2) ? -swappedSine : swappedSine;
+        cosine = ((quadrant + 1) & 2) ? -swappedCosine : swappedCosine;
+    }
+
+    inline void sincos(GLfloat radians, GLfloat &sine, GLfloat &cosine)
+    {
+        GLfloat quadrant = (radians * TwoOverPi + RoundingConstant) - RoundingConstant;
+        GLfloat r = radians - quadrant * PiOver2Part1;
+        r = r - quadrant * PiOver2Part2;
+        r = r - quadrant * PiOver2Part3;
+
+        sincosReduced(r, static_cast<int>(quadrant), sine, cosine);
+    }
+
+    //Reduces in degrees, where multiples of 90 are exact, before converting to radians.
+    //So 90, 180, 270 ... give exactly 0 and +-1, and large angles keep their precision.
+    inline void sincosDegrees(GLfloat degrees, GLfloat &sine, GLfloat &cosine)
+    {
+        GLfloat quadrant = (degrees * (1.f / 90.f) + RoundingConstant) - RoundingConstant;
+        GLfloat r = (degrees - quadrant * 90.f) * (PI / 180.f);
+
+        sincosReduced(r, static_cast<int>(quadrant), sine, cosine);
+    }
+
+    //Bulk version for many angles at once, ex. animating lots of rotating objects.
+    //Uses the SIMD kernels in gsl_simd. Any of the output arrays may be the input array.
+    inline void sincos(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count)
+    {
+        simd::sincosArray(radians, sines, cosines, count);
+    }
+
+} //namespace fast
+
+    //Sine and cosine of an angle in degrees, used by the rotate functions.
+    //Uses std::sin/std::cos unless GSL_FAST_TRIG is defined (see gsl.pri).
+    inline void sincosDegrees(GLfloat degrees, GLfloat &sine, GLfloat &cosine)
+    {
+#ifdef GSL_FAST_TRIG
+        fast::sincosDegrees(degrees, sine, cosine);
+#else
+        GLfloat rad = degrees * (PI / 180.f);
+        sine = std::sin(rad);
+        cosine = std::cos(rad);
+#endif
+    }
+
+} //namespace gsl
+
+#endif // FASTMATH_H
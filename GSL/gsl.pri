@@ -0,0 +1,30 @@
+# Game School Lib - shared by the engine and the benchmarks.
+# Pulled in with include(), paths are relative to this file.
+
+INCLUDEPATH += $$PWD
+
+# Polynomial sin/cos in the rotate functions instead of std::sin/std::cos - see fastmath.h
+#DEFINES += GSL_FAST_TRIG
+
+HEADERS += \
+    $$PWD/batchtransform.h \
+    $$PWD/beziercurve.h \
+    $$PWD/bsplinecurve.h \
+    $$PWD/matrix2x2.h \
+    $$PWD/matrix3x3.h \
+    $$PWD/matrix4x4.h \
+    $$PWD/quaternion.h \
+    $$PWD/vector2d.h \
+    $$PWD/vector3d.h \
+    $$PWD/vector4d.h \
+    $$PWD/fastmath.h \
+    $$PWD/gsl_math.h \
+    $$PWD/gsl_simd.h \
+    $$PWD/math_constants.h
+
+SOURCES += \
+    $$PWD/batchtransform.cpp \
+    $$PWD/beziercurve.cpp \
+    $$PWD/bsplinecurve.cpp \
+    $$PWD/gsl_math.cpp \
+    $$PWD/gsl_simd.cpp
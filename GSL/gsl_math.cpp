@@ -6,26 +6,6 @@
 
 namespace gsl
 {
-    GLdouble rad2deg(GLdouble rad)
-    {
-        return rad * (180.0 / PI_D);
-    }
-
-    GLdouble deg2rad(GLdouble deg)
-    {
-        return deg * (PI_D / 180.0);
-    }
-
-    GLfloat rad2degf(GLfloat rad)
-    {
-        return rad * (180.0f / PI);
-    }
-
-    GLfloat deg2radf(GLfloat deg)
-    {
-        return deg * (PI / 180.0f);
-    }
-
     //Calculates the points on a bezier curve. Input t from 0 to 1
     Vector3D bezierCurve(std::vector<Vector3D> points, GLfloat t, unsigned long long degree)
     {
@@ -90,51 +70,6 @@ namespace gsl
         return result;
     }
 
-    Vector3D up()
-    {
-        return Vector3D{0.f, 1.f, 0.f};
-    }
-
-    Vector3D right()
-    {
-        return Vector3D{1.f, 0.f, 0.f};
-    }
-
-    Vector3D forward()
-    {
-        return Vector3D{0.f, 0.f, 1.f};
-    }
-
-    Vector3D one()
-    {
-        return Vector3D{1.f, 1.f, 1.f};
-    }
-
-    Vector3D zero()
-    {
-        return Vector3D{0.f, 0.f, 0.f};
-    }
-
-    GLfloat clamp(GLfloat x, GLfloat min, GLfloat max)
-    {
-        if (x < min)
-            x = min;
-        else if (x > max)
-            x = max;
-
-        return x;
-    }
-
-    Vector2D lerp2D(GLfloat time, Vector2D a, Vector2D b)
-    {
-        return (a * (1.f - time)) + (b * time);
-    }
-
-    Vector3D lerp3D(GLfloat time, Vector3D a, Vector3D b)
-    {
-        return (a * (1.f - time)) + (b * time);
-    }
-
     float distanceToPlane(const Vector3D &point, const Vector3D &normal, const Vector3D &pointInPlane)
     {
 //        Bruk planformelen Ax + By + Cz - D = 0 (hvor (A,B,C) er plan-normalen og D blir regnet ut ved å legge et punkt i x, y, z).
@@ -157,14 +92,18 @@ namespace gsl
         return distance;
     }
 
-    bool withinPlane(const Vector3D &point, Matrix4x4 &modelMatrix, Vector2D upright, Vector2D downleft)
+    bool withinPlane(const Vector3D &point, const Matrix4x4 &modelMatrix, Vector2D upright, Vector2D downleft)
     {
         Matrix4x4 inversed = modelMatrix;
         inversed.inverse();
-        //rotate point to local space of Plane
-        Vector4D transposedPoint = inversed * Vector4D(point, 1.f);
 
-        qDebug() << "TransposedPoint: " << transposedPoint.toVector3D();
+        return withinPlaneInverse(point, inversed, upright, downleft);
+    }
+
+    bool withinPlaneInverse(const Vector3D &point, const Matrix4x4 &inverseModelMatrix, Vector2D upright, Vector2D downleft)
+    {
+        //rotate point to local space of Plane
+        Vector4D transposedPoint = inverseModelMatrix * Vector4D(point, 1.f);
 
         //Test if point is within x and y
 
@@ -12,30 +12,61 @@
 namespace gsl
 {
     //Functions
-    GLdouble rad2deg(GLdouble rad);
-    GLdouble deg2rad(GLdouble deg);
-    GLfloat rad2degf(GLfloat rad);
-    GLfloat deg2radf(GLfloat deg);
-    GLfloat clamp(GLfloat x, GLfloat min, GLfloat max);
+    constexpr GLdouble rad2deg(GLdouble rad)
+    {
+        return rad * (180.0 / PI_D);
+    }
+    constexpr GLdouble deg2rad(GLdouble deg)
+    {
+        return deg * (PI_D / 180.0);
+    }
+    constexpr GLfloat rad2degf(GLfloat rad)
+    {
+        return rad * (180.0f / PI);
+    }
+    constexpr GLfloat deg2radf(GLfloat deg)
+    {
+        return deg * (PI / 180.0f);
+    }
+    constexpr GLfloat clamp(GLfloat x, GLfloat min, GLfloat max)
+    {
+        if (x < min)
+            x = min;
+        else if (x > max)
+            x = max;
+
+        return x;
+    }
 
     //Interpolation
     //Remember time can only be between 0 and 1
-    Vector2D lerp2D(GLfloat time, Vector2D start, Vector2D end); // Move a straight line with linear time-step between points
-    Vector3D lerp3D(GLfloat time, Vector3D start, Vector3D end);
+    // Move a straight line with linear time-step between points
+    constexpr Vector2D lerp2D(GLfloat time, Vector2D start, Vector2D end)
+    {
+        return (start * (1.f - time)) + (end * time);
+    }
+    constexpr Vector3D lerp3D(GLfloat time, Vector3D start, Vector3D end)
+    {
+        return (start * (1.f - time)) + (end * time);
+    }
 
     //Curves
+    //Copies points on every call - use BezierCurve (beziercurve.h) when sampling the same curve many times
     Vector3D bezierCurve(std::vector<Vector3D> points, GLfloat t, unsigned long long degree = 3);
+    //Allocates the basis on every call - use BSplineCurve (bsplinecurve.h) for dense sampling
     Vector3D bSpline(const std::vector<Vector3D> &points, const std::vector<GLfloat> &t, GLfloat x, unsigned long long degree = 3);
 
     //Basic vector directions
-    Vector3D up();
-    Vector3D right();
-    Vector3D forward();
-    Vector3D one();
-    Vector3D zero();
+    constexpr Vector3D up() { return Vector3D{0.f, 1.f, 0.f}; }
+    constexpr Vector3D right() { return Vector3D{1.f, 0.f, 0.f}; }
+    constexpr Vector3D forward() { return Vector3D{0.f, 0.f, 1.f}; }
+    constexpr Vector3D one() { return Vector3D{1.f, 1.f, 1.f}; }
+    constexpr Vector3D zero() { return Vector3D{0.f, 0.f, 0.f}; }
 
     float distanceToPlane(const Vector3D &point, const Vector3D &normal, const Vector3D &pointInPlane);
-    bool withinPlane(const Vector3D &point, Matrix4x4 &modelMatrix, Vector2D upright, Vector2D downleft);
+    bool withinPlane(const Vector3D &point, const Matrix4x4 &modelMatrix, Vector2D upright, Vector2D downleft);
+    //Same as withinPlane, but takes an already inverted model matrix, ex. VisualObject::inverseMatrix()
+    bool withinPlaneInverse(const Vector3D &point, const Matrix4x4 &inverseModelMatrix, Vector2D upright, Vector2D downleft);
 
 } //namespace
 
@@ -0,0 +1,445 @@
+#include "gsl_simd.h"
+#include "fastmath.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GSL_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//GCC and Clang need to be told a function may use AVX, MSVC does not
+#if defined(GSL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GSL_TARGET_AVX __attribute__((target("avx")))
+#else
+#define GSL_TARGET_AVX
+#endif
+
+namespace gsl
+{
+namespace simd
+{
+    void multiplyMatrix4x4Scalar(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out)
+    {
+        for (int y = 0; y < 4; y++)
+        {
+            const GLfloat *row = lhs + y * 4;
+            for (int x = 0; x < 4; x++)
+            {
+                out[y * 4 + x] = row[0] * rhs[x] + row[1] * rhs[4 + x] + row[2] * rhs[8 + x] + row[3] * rhs[12 + x];
+            }
+        }
+    }
+
+    void multiplyMatrix4x4Vector4Scalar(const GLfloat *m, const GLfloat *v, GLfloat *out)
+    {
+        for (int y = 0; y < 4; y++)
+        {
+            const GLfloat *row = m + y * 4;
+            out[y] = row[0] * v[0] + row[1] * v[1] + row[2] * v[2] + row[3] * v[3];
+        }
+    }
+
+    void transformVector3ArrayScalar(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count, GLfloat w)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            GLfloat x = in[i * 3], y = in[i * 3 + 1], z = in[i * 3 + 2];
+            out[i * 3]     = m[0] * x + m[1] * y + m[2]  * z + m[3]  * w;
+            out[i * 3 + 1] = m[4] * x + m[5] * y + m[6]  * z + m[7]  * w;
+            out[i * 3 + 2] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+        }
+    }
+
+    void transformVector4ArrayScalar(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            GLfloat v[4] = {in[i * 4], in[i * 4 + 1], in[i * 4 + 2], in[i * 4 + 3]};
+            multiplyMatrix4x4Vector4Scalar(m, v, out + i * 4);
+        }
+    }
+
+    void sincosArrayScalar(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            GLfloat s, c;
+            fast::sincos(radians[i], s, c);
+            sines[i] = s;
+            cosines[i] = c;
+        }
+    }
+
+    void shuffleBytes4Scalar(const unsigned char *in, unsigned char *out, std::size_t count, const unsigned char *order)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const unsigned char *group = in + i * 4;
+            unsigned char shuffled[4] = {group[order[0]], group[order[1]], group[order[2]], group[order[3]]};
+            out[i * 4]     = shuffled[0];
+            out[i * 4 + 1] = shuffled[1];
+            out[i * 4 + 2] = shuffled[2];
+            out[i * 4 + 3] = shuffled[3];
+        }
+    }
+
+#ifdef GSL_SIMD_X86
+    //Each row of the result is a linear combination of the rows of rhs:
+    //out.row(y) = lhs(y,0)*rhs.row(0) + lhs(y,1)*rhs.row(1) + ...
+    void multiplyMatrix4x4SSE(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out)
+    {
+        const __m128 r0 = _mm_loadu_ps(rhs);
+        const __m128 r1 = _mm_loadu_ps(rhs + 4);
+        const __m128 r2 = _mm_loadu_ps(rhs + 8);
+        const __m128 r3 = _mm_loadu_ps(rhs + 12);
+
+        for (int y = 0; y < 4; y++)
+        {
+            const GLfloat *row = lhs + y * 4;
+            __m128 result = _mm_mul_ps(_mm_set1_ps(row[0]), r0);
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[1]), r1));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[2]), r2));
+            result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[3]), r3));
+            _mm_storeu_ps(out + y * 4, result);
+        }
+    }
+
+    //Same as the SSE version, but two result rows at a time in one 256 bit register
+    GSL_TARGET_AVX void multiplyMatrix4x4AVX(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out)
+    {
+        const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs));
+        const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 4));
+        const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 8));
+        const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 12));
+
+        for (int y = 0; y < 4; y += 2)
+        {
+            const GLfloat *a = lhs + y * 4;     //row y
+            const GLfloat *b = a + 4;           //row y+1
+            __m256 result = _mm256_mul_ps(_mm256_setr_ps(a[0], a[0], a[0], a[0], b[0], b[0], b[0], b[0]), r0);
+            result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(a[1], a[1], a[1], a[1], b[1], b[1], b[1], b[1]), r1));
+            result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(a[2], a[2], a[2], a[2], b[2], b[2], b[2], b[2]), r2));
+            result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(a[3], a[3], a[3], a[3], b[3], b[3], b[3], b[3]), r3));
+            _mm256_storeu_ps(out + y * 4, result);
+        }
+    }
+
+    //The matrix is row-major, so transpose it to get the columns and
+    //sum col0*v.x + col1*v.y + col2*v.z + col3*v.w
+    void multiplyMatrix4x4Vector4SSE(const GLfloat *m, const GLfloat *v, GLfloat *out)
+    {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        __m128 result = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+        result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+        _mm_storeu_ps(out, result);
+    }
+
+    //Works on 4 points at a time in structure-of-arrays form:
+    //the 12 floats x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 are shuffled into
+    //xxxx, yyyy, zzzz, transformed with one broadcast matrix element per multiply,
+    //and shuffled back.
+    void transformVector3ArraySSE(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count, GLfloat w)
+    {
+        const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]),  m3 = _mm_set1_ps(m[3] * w);
+        const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]),  m7 = _mm_set1_ps(m[7] * w);
+        const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]), m11 = _mm_set1_ps(m[11] * w);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const GLfloat *src = in + i * 3;
+            __m128 a = _mm_loadu_ps(src);
+            __m128 b = _mm_loadu_ps(src + 4);
+            __m128 c = _mm_loadu_ps(src + 8);
+
+            __m128 b2b3c0c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+            __m128 x = _mm_shuffle_ps(a, b2b3c0c1, _MM_SHUFFLE(3, 0, 3, 0));
+            __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                                      _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                                      _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z)), m3);
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m4, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m6, z)), m7);
+            __m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m8, x), _mm_mul_ps(m9, y)), _mm_mul_ps(m10, z)), m11);
+
+            __m128 xy01 = _mm_unpacklo_ps(rx, ry);
+            __m128 xy23 = _mm_unpackhi_ps(rx, ry);
+            GLfloat *dst = out + i * 3;
+            _mm_storeu_ps(dst, _mm_shuffle_ps(xy01, _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, xy23, _MM_SHUFFLE(2, 2, 2, 2)),
+                                                  _mm_shuffle_ps(xy23, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        transformVector3ArrayScalar(m, in + i * 3, out + i * 3, count - i, w);
+    }
+
+    void transformVector4ArraySSE(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count)
+    {
+        __m128 c0 = _mm_loadu_ps(m);
+        __m128 c1 = _mm_loadu_ps(m + 4);
+        __m128 c2 = _mm_loadu_ps(m + 8);
+        __m128 c3 = _mm_loadu_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const GLfloat *v = in + i * 4;
+            __m128 result = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+            result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+            result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+            result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+            _mm_storeu_ps(out + i * 4, result);
+        }
+    }
+
+    //fast::sincos on 4 angles. The quadrant picks the result without branches:
+    //bit 0 swaps sine and cosine, bit 1 flips the sign of the sine, bit 1 of quadrant + 1 the cosine.
+    static inline void sincos4SSE(__m128 x, __m128 &sine, __m128 &cosine)
+    {
+        __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(fast::TwoOverPi)));
+        __m128 q = _mm_cvtepi32_ps(quadrant);
+
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(fast::PiOver2Part1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(fast::PiOver2Part2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(fast::PiOver2Part3)));
+        __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fast::SinCoefficient3), r2), _mm_set1_ps(fast::SinCoefficient2));
+        s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(fast::SinCoefficient1));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(fast::CosCoefficient3), r2), _mm_set1_ps(fast::CosCoefficient2));
+        c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(fast::CosCoefficient1));
+        c = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, r2), r2), _mm_mul_ps(_mm_set1_ps(0.5f), r2));
+        c = _mm_add_ps(c, _mm_set1_ps(1.f));
+
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+        __m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+        __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+
+        sine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sineSign);
+        cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosineSign);
+    }
+
+    void sincosArraySSE(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 s, c;
+            sincos4SSE(_mm_loadu_ps(radians + i), s, c);
+            _mm_storeu_ps(sines + i, s);
+            _mm_storeu_ps(cosines + i, c);
+        }
+
+        sincosArrayScalar(radians + i, sines + i, cosines + i, count - i);
+    }
+
+    GSL_TARGET_AVX static inline __m256 combine(__m128i low, __m128i high)
+    {
+        return _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(low), high, 1));
+    }
+
+    //Same as the SSE version on 8 angles. AVX has no 256 bit integer instructions,
+    //so the quadrant bit tricks are done on the two 128 bit halves.
+    GSL_TARGET_AVX void sincosArrayAVX(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count)
+    {
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(radians + i);
+            __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(fast::TwoOverPi)));
+            __m256 q = _mm256_cvtepi32_ps(quadrant);
+
+            __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(fast::PiOver2Part1)));
+            r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(fast::PiOver2Part2)));
+            r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(fast::PiOver2Part3)));
+            __m256 r2 = _mm256_mul_ps(r, r);
+
+            __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(fast::SinCoefficient3), r2), _mm256_set1_ps(fast::SinCoefficient2));
+            s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(fast::SinCoefficient1));
+            s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, r2), r), r);
+
+            __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(fast::CosCoefficient3), r2), _mm256_set1_ps(fast::CosCoefficient2));
+            c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(fast::CosCoefficient1));
+            c = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(c, r2), r2), _mm256_mul_ps(_mm256_set1_ps(0.5f), r2));
+            c = _mm256_add_ps(c, _mm256_set1_ps(1.f));
+
+            __m128i low = _mm256_castsi256_si128(quadrant);
+            __m128i high = _mm256_extractf128_si256(quadrant, 1);
+            __m256 swap = combine(_mm_cmpeq_epi32(_mm_and_si128(low, one), one),
+                                  _mm_cmpeq_epi32(_mm_and_si128(high, one), one));
+            __m256 sineSign = combine(_mm_slli_epi32(_mm_and_si128(low, two), 30),
+                                      _mm_slli_epi32(_mm_and_si128(high, two), 30));
+            __m256 cosineSign = combine(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(low, one), two), 30),
+                                        _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(high, one), two), 30));
+
+            _mm256_storeu_ps(sines + i, _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign));
+            _mm256_storeu_ps(cosines + i, _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign));
+        }
+
+        sincosArraySSE(radians + i, sines + i, cosines + i, count - i);
+    }
+
+    //pshufb is SSSE3, which every AVX CPU has. Plain SSE2 has no byte shuffle, so the SSE kernels use the scalar one.
+    //8 groups per loop, in two 16 byte registers
+    GSL_TARGET_AVX void shuffleBytes4AVX(const unsigned char *in, unsigned char *out, std::size_t count,
+                                         const unsigned char *order)
+    {
+        const __m128i mask = _mm_setr_epi8(order[0], order[1], order[2], order[3],
+                                           order[0] + 4, order[1] + 4, order[2] + 4, order[3] + 4,
+                                           order[0] + 8, order[1] + 8, order[2] + 8, order[3] + 8,
+                                           order[0] + 12, order[1] + 12, order[2] + 12, order[3] + 12);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4 + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_shuffle_epi8(a, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4 + 16), _mm_shuffle_epi8(b, mask));
+        }
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_shuffle_epi8(a, mask));
+        }
+
+        shuffleBytes4Scalar(in + i * 4, out + i * 4, count - i, order);
+    }
+
+    static bool cpuSupportsAVX()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        //The OS must also save the YMM registers on context switches
+        return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx");
+#endif
+    }
+#endif //GSL_SIMD_X86
+
+    //The function pointers the public entry points go through
+    struct Kernels
+    {
+        InstructionSet set;
+        void (*matrixMatrix)(const GLfloat *, const GLfloat *, GLfloat *);
+        void (*matrixVector)(const GLfloat *, const GLfloat *, GLfloat *);
+        void (*vector3Array)(const GLfloat *, const GLfloat *, GLfloat *, std::size_t, GLfloat);
+        void (*vector4Array)(const GLfloat *, const GLfloat *, GLfloat *, std::size_t);
+        void (*sincos)(const GLfloat *, GLfloat *, GLfloat *, std::size_t);
+        void (*shuffle4)(const unsigned char *, unsigned char *, std::size_t, const unsigned char *);
+    };
+
+    static Kernels kernelsFor(InstructionSet set)
+    {
+        switch (set)
+        {
+#ifdef GSL_SIMD_X86
+        case InstructionSet::AVX:
+            return {set, multiplyMatrix4x4AVX, multiplyMatrix4x4Vector4SSE,
+                    transformVector3ArraySSE, transformVector4ArraySSE, sincosArrayAVX, shuffleBytes4AVX};
+        case InstructionSet::SSE:
+            return {set, multiplyMatrix4x4SSE, multiplyMatrix4x4Vector4SSE,
+                    transformVector3ArraySSE, transformVector4ArraySSE, sincosArraySSE, shuffleBytes4Scalar};
+#endif
+        default:
+            return {InstructionSet::Scalar, multiplyMatrix4x4Scalar, multiplyMatrix4x4Vector4Scalar,
+                    transformVector3ArrayScalar, transformVector4ArrayScalar, sincosArrayScalar,
+                    shuffleBytes4Scalar};
+        }
+    }
+
+    static Kernels &kernels()
+    {
+        static Kernels active = kernelsFor(supportedInstructionSet());
+        return active;
+    }
+
+    InstructionSet supportedInstructionSet()
+    {
+#ifdef GSL_SIMD_X86
+        static const InstructionSet supported = cpuSupportsAVX() ? InstructionSet::AVX : InstructionSet::SSE;
+        return supported;
+#else
+        return InstructionSet::Scalar;
+#endif
+    }
+
+    InstructionSet activeInstructionSet()
+    {
+        return kernels().set;
+    }
+
+    void setInstructionSet(InstructionSet set)
+    {
+        if (static_cast<int>(set) > static_cast<int>(supportedInstructionSet()))
+            set = supportedInstructionSet();
+        kernels() = kernelsFor(set);
+    }
+
+    const char *instructionSetName(InstructionSet set)
+    {
+        switch (set)
+        {
+        case InstructionSet::AVX:
+            return "AVX";
+        case InstructionSet::SSE:
+            return "SSE";
+        default:
+            return "Scalar";
+        }
+    }
+
+    void multiplyMatrix4x4(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out)
+    {
+        kernels().matrixMatrix(lhs, rhs, out);
+    }
+
+    void multiplyMatrix4x4Vector4(const GLfloat *m, const GLfloat *v, GLfloat *out)
+    {
+        kernels().matrixVector(m, v, out);
+    }
+
+    void transformVector3Array(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count, GLfloat w)
+    {
+        kernels().vector3Array(m, in, out, count, w);
+    }
+
+    void transformVector4Array(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count)
+    {
+        kernels().vector4Array(m, in, out, count);
+    }
+
+    void sincosArray(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count)
+    {
+        kernels().sincos(radians, sines, cosines, count);
+    }
+
+    void shuffleBytes4(const unsigned char *in, unsigned char *out, std::size_t count, const unsigned char *order)
+    {
+        kernels().shuffle4(in, out, count, order);
+    }
+
+} //namespace simd
+} //namespace gsl
@@ -0,0 +1,65 @@
+#ifndef GSL_SIMD_H
+#define GSL_SIMD_H
+
+#include "gltypes.h"
+#include <cstddef>
+
+namespace gsl
+{
+namespace simd
+{
+    //Instruction sets the math kernels can run on, picked at runtime from what the CPU supports
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE,
+        AVX
+    };
+
+    //The best instruction set the CPU (and OS) supports
+    InstructionSet supportedInstructionSet();
+
+    //The instruction set currently used by the kernels below
+    InstructionSet activeInstructionSet();
+
+    //Force a specific path, ex. to compare SIMD and scalar results.
+    //Clamped to what the CPU supports. Not thread safe - call before any heavy math starts.
+    void setInstructionSet(InstructionSet set);
+
+    const char *instructionSetName(InstructionSet set);
+
+    //Row-major 4x4 * 4x4. out may not alias lhs or rhs.
+    //All paths do the multiplies and adds in the same order as the scalar code,
+    //so they give bit-exact results (no FMA).
+    void multiplyMatrix4x4(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out);
+
+    //Row-major 4x4 * 4D column vector. out may not alias m or v.
+    void multiplyMatrix4x4Vector4(const GLfloat *m, const GLfloat *v, GLfloat *out);
+
+    //Transforms count tightly packed xyz triples with a row-major 4x4, using w as the 4th component
+    //(1 for points, 0 for directions). Only x, y and z of the result are written.
+    //in and out may be the same array.
+    void transformVector3Array(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count, GLfloat w);
+
+    //Transforms count xyzw quadruples with a row-major 4x4. in and out may be the same array.
+    void transformVector4Array(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count);
+
+    //gsl::fast::sincos on count angles in radians. Any of the output arrays may be the input array.
+    void sincosArray(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count);
+
+    //Reorders the bytes of count 4 byte groups (ex. pixel channels): out[i * 4 + c] = in[i * 4 + order[c]].
+    //Each order[c] must be 0 - 3. in and out may be the same array.
+    void shuffleBytes4(const unsigned char *in, unsigned char *out, std::size_t count, const unsigned char *order);
+
+    //The plain C++ versions, always available
+    void multiplyMatrix4x4Scalar(const GLfloat *lhs, const GLfloat *rhs, GLfloat *out);
+    void multiplyMatrix4x4Vector4Scalar(const GLfloat *m, const GLfloat *v, GLfloat *out);
+    void transformVector3ArrayScalar(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count, GLfloat w);
+    void transformVector4ArrayScalar(const GLfloat *m, const GLfloat *in, GLfloat *out, std::size_t count);
+    void sincosArrayScalar(const GLfloat *radians, GLfloat *sines, GLfloat *cosines, std::size_t count);
+    void shuffleBytes4Scalar(const unsigned char *in, unsigned char *out, std::size_t count, const unsigned char *order);
+
+} //namespace simd
+} //namespace gsl
+
+#endif // GSL_SIMD_H
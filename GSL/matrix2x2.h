@@ -6,6 +6,8 @@
 #include "gltypes.h"
 #include <utility>
 #include <iomanip>
+#include <initializer_list>
+#include <type_traits>
 
 namespace gsl
 {
@@ -16,24 +18,82 @@ class Matrix4x4;
 class Matrix2x2
 {
 public:
-    Matrix2x2(bool isIdentity = false);
-    Matrix2x2(std::initializer_list<GLfloat> values);
+    constexpr Matrix2x2(bool isIdentity = false) : matrix{}
+    {
+        if(isIdentity)
+            setToIdentity();
+    }
+    constexpr Matrix2x2(std::initializer_list<GLfloat> values) : matrix{}
+    {
+        int i = 0;
+        for(auto value : values)
+            matrix[i++] = value;
+    }
+
+    constexpr Matrix2x2 identity()
+    {
+        setToIdentity();
+
+        return *this;
+    }
+    constexpr void setToIdentity()
+    {
+        matrix[0] = 1.f; matrix[1] = 0.f;
+        matrix[2] = 0.f; matrix[3] = 1.f;
+    }
 
-    Matrix2x2 identity();
-    void setToIdentity();
+    constexpr GLfloat determinant() const
+    {
+        return (matrix[0]*matrix[3] - matrix[1]*matrix[2]);
+    }
+    constexpr bool inverse()
+    {
+        GLfloat det = determinant();
+
+        if(det == 0.f)
+            return false;
+
+        det = 1.f / det;
 
-    GLfloat determinant();
-    bool inverse();
+        *this =
+        {
+             det*matrix[3], -det*matrix[1],
+            -det*matrix[2],  det*matrix[0]
+        };
 
-    void transpose();
+        return true;
+    }
 
-    Matrix3x3 toMatrix3();
-    Matrix4x4 toMatrix4();
+    constexpr void transpose()
+    {
+        GLfloat temp = matrix[1];
+        matrix[1] = matrix[2];
+        matrix[2] = temp;
+    }
 
-    Matrix2x2 operator*(const Matrix2x2 &other);
-    Vector2D operator*(const Vector2D &v);
-    GLfloat& operator()(int y, int x);
-    GLfloat operator()(int y, int x) const;
+    Matrix3x3 toMatrix3() const;
+    Matrix4x4 toMatrix4() const;
+
+    constexpr Matrix2x2 operator*(const Matrix2x2 &other) const
+    {
+        return Matrix2x2
+        {
+            matrix[0] * other.matrix[0] + matrix[1] * other.matrix[2], matrix[0] * other.matrix[1] + matrix[1] * other.matrix[3],
+            matrix[2] * other.matrix[0] + matrix[3] * other.matrix[2], matrix[2] * other.matrix[1] + matrix[3] * other.matrix[3]
+        };
+    }
+    constexpr Vector2D operator*(const Vector2D &v) const
+    {
+        return Vector2D(matrix[0] * v.x + matrix[1] * v.y, matrix[2] * v.x + matrix[3] * v.y);
+    }
+    constexpr GLfloat& operator()(int y, int x)
+    {
+        return matrix[y * 2 + x];
+    }
+    constexpr GLfloat operator()(int y, int x) const
+    {
+        return matrix[y * 2 + x];
+    }
 
     friend std::ostream& operator<<(std::ostream &output, const Matrix2x2 &mIn)
     {
@@ -47,6 +107,39 @@ private:
     GLfloat matrix[4];
 };
 
+static_assert(std::is_trivially_copyable<Matrix2x2>::value, "Matrix2x2 must be trivially copyable");
+static_assert(sizeof(Matrix2x2) == 4 * sizeof(GLfloat), "Matrix2x2 must be four packed floats");
+
+} //namespace
+
+//The other matrix types are needed to define the conversions
+#include "matrix3x3.h"
+#include "matrix4x4.h"
+
+namespace gsl
+{
+
+inline Matrix3x3 Matrix2x2::toMatrix3() const
+{
+    return Matrix3x3
+    {
+        matrix[0], matrix[1], 0,
+        matrix[2], matrix[3], 0,
+            0,        0,      1
+    };
+}
+
+inline Matrix4x4 Matrix2x2::toMatrix4() const
+{
+    return Matrix4x4
+    {
+        matrix[0], matrix[1], 0, 0,
+        matrix[2], matrix[3], 0, 0,
+            0,        0,      1, 0,
+            0,        0,      0, 1
+    };
+}
+
 } //namespace
 
 #endif // MATRIX2X2_H
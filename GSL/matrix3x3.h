@@ -5,6 +5,8 @@
 #include "gltypes.h"
 #include <utility>
 #include <iomanip>
+#include <initializer_list>
+#include <type_traits>
 
 namespace gsl
 {
@@ -15,25 +17,111 @@ class Matrix4x4;
 class Matrix3x3
 {
 public:
-    Matrix3x3(bool isIdentity = false);
-    Matrix3x3(std::initializer_list<GLfloat> values);
+    constexpr Matrix3x3(bool isIdentity = false) : matrix{}
+    {
+        if(isIdentity)
+            setToIdentity();
+    }
+    constexpr Matrix3x3(std::initializer_list<GLfloat> values) : matrix{}
+    {
+        int i = 0;
+        for(auto value : values)
+            matrix[i++] = value;
+    }
+
+    constexpr Matrix3x3 identity()
+    {
+        setToIdentity();
+
+        return *this;
+    }
+    constexpr void setToIdentity()
+    {
+        for(int i = 0; i < 9; i++)
+            matrix[i] = (i % 4 == 0) ? 1.f : 0.f;
+    }
+
+    constexpr GLfloat determinant() const
+    {
+        //det = a(ei − fh) − b(di − fg) + c(dh − eg)
+        //where
+        //    a, b, c,
+        //    d, e, f
+        //    g, h, i
 
-    Matrix3x3 identity();
-    void setToIdentity();
+        return matrix[0]*(matrix[4]*matrix[8]-matrix[5]*matrix[7])
+             - matrix[1]*(matrix[3]*matrix[8]-matrix[5]*matrix[6])
+             + matrix[2]*(matrix[3]*matrix[7]-matrix[4]*matrix[6]);
+    }
+
+    constexpr bool inverse()
+    {
+        GLfloat a = (*this)(0, 0), b = (*this)(0, 1), c = (*this)(0, 2),
+                d = (*this)(1, 0), e = (*this)(1, 1), f = (*this)(1, 2),
+                g = (*this)(2, 0), h = (*this)(2, 1), i = (*this)(2, 2);
+
+        GLfloat A =  (e*i-f*h), B = -(d*i-f*g), C =  (d*h-e*g),
+                D = -(b*i-c*h), E =  (a*i-c*g), F = -(a*h-b*g),
+                G =  (b*f-c*e), H = -(a*f-c*d), I =  (a*e-b*d);
+
+        GLfloat det = determinant();
+
+        if(det == 0.f)
+            return false;
 
-    GLfloat determinant();
+        det = 1.f/det;
+
+        *this =
+        {
+            det*A, det*D, det*G,
+            det*B, det*E, det*H,
+            det*C, det*F, det*I
+        };
+
+        return true;
+    }
+
+    constexpr void transpose()
+    {
+        swapElements(1, 3);
+        swapElements(2, 6);
+        swapElements(5, 7);
+    }
 
-    bool inverse();
+    Matrix2x2 toMatrix2() const;
+    Matrix4x4 toMatrix4() const;
 
-    void transpose();
+    constexpr Matrix3x3 operator*(const Matrix3x3 &other) const
+    {
+        return
+        {
+            matrix[0] * other.matrix[0] + matrix[1] * other.matrix[3] + matrix[2] * other.matrix[6],
+            matrix[0] * other.matrix[1] + matrix[1] * other.matrix[4] + matrix[2] * other.matrix[7],
+            matrix[0] * other.matrix[2] + matrix[1] * other.matrix[5] + matrix[2] * other.matrix[8],
 
-    Matrix2x2 toMatrix2();
-    Matrix4x4 toMatrix4();
+            matrix[3] * other.matrix[0] + matrix[4] * other.matrix[3] + matrix[5] * other.matrix[6],
+            matrix[3] * other.matrix[1] + matrix[4] * other.matrix[4] + matrix[5] * other.matrix[7],
+            matrix[3] * other.matrix[2] + matrix[4] * other.matrix[5] + matrix[5] * other.matrix[8],
 
-    Matrix3x3 operator*(const Matrix3x3 &other);
-    Vector3D operator*(const Vector3D &v);
-    GLfloat& operator()(int y, int x);
-    GLfloat operator()(int y, int x) const;
+            matrix[6] * other.matrix[0] + matrix[7] * other.matrix[3] + matrix[8] * other.matrix[6],
+            matrix[6] * other.matrix[1] + matrix[7] * other.matrix[4] + matrix[8] * other.matrix[7],
+            matrix[6] * other.matrix[2] + matrix[7] * other.matrix[5] + matrix[8] * other.matrix[8]
+        };
+    }
+    constexpr Vector3D operator*(const Vector3D &v) const
+    {
+        return Vector3D(matrix[0] * v.x + matrix[1] * v.y + matrix[2] * v.z,
+                        matrix[3] * v.x + matrix[4] * v.y + matrix[5] * v.z,
+                        matrix[6] * v.x + matrix[7] * v.y + matrix[8] * v.z);
+    }
+    constexpr GLfloat& operator()(int y, int x)
+    {
+        return matrix[y * 3 + x];
+    }
+    constexpr GLfloat operator()(int y, int x) const
+    {
+        return matrix[y * 3 + x];
+    }
 
     friend std::ostream& operator<<(std::ostream &output, const Matrix3x3 &mIn)
     {
@@ -45,9 +133,48 @@ public:
     }
 
 private:
+    constexpr void swapElements(int a, int b)
+    {
+        GLfloat temp = matrix[a];
+        matrix[a] = matrix[b];
+        matrix[b] = temp;
+    }
+
     GLfloat matrix[9];
 };
 
+static_assert(std::is_trivially_copyable<Matrix3x3>::value, "Matrix3x3 must be trivially copyable");
+static_assert(sizeof(Matrix3x3) == 9 * sizeof(GLfloat), "Matrix3x3 must be nine packed floats");
+
+} //namespace
+
+//The other matrix types are needed to define the conversions
+#include "matrix2x2.h"
+#include "matrix4x4.h"
+
+namespace gsl
+{
+
+inline Matrix2x2 Matrix3x3::toMatrix2() const
+{
+    return Matrix2x2
+    {
+        matrix[0], matrix[1],
+        matrix[3], matrix[4]
+    };
+}
+
+inline Matrix4x4 Matrix3x3::toMatrix4() const
+{
+    return Matrix4x4
+    {
+        matrix[0], matrix[1], matrix[2], 0,
+        matrix[3], matrix[4], matrix[5], 0,
+        matrix[6], matrix[7], matrix[8], 0,
+            0,        0,         0,      0
+    };
+}
+
 } //namespace
 
 #endif // MATRIX3X3_H
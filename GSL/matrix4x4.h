@@ -3,68 +3,90 @@
 
 #include "vector3d.h"
 #include "vector4d.h"
+#include "math_constants.h"
+#include "fastmath.h"
+#include "gsl_simd.h"
 #include "gltypes.h"
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <initializer_list>
+#include <type_traits>
 
 namespace gsl
 {
 class Matrix2x2;
 class Matrix3x3;
+class Quaternion;
 
 class Matrix4x4
 {
 public:
-    Matrix4x4(bool isIdentity = false);
-    Matrix4x4(std::initializer_list<GLfloat> values);
+    constexpr Matrix4x4(bool isIdentity = false) : matrix{}
+    {
+        if(isIdentity)
+            setToIdentity();
+    }
+    constexpr Matrix4x4(std::initializer_list<GLfloat> values) : matrix{}
+    {
+        //Initializing the matrix class the same way as a 2d array
+        int i = 0;
+        for(auto value : values)
+            matrix[i++] = value;
+    }
 
-    Matrix4x4 identity();
-    void setToIdentity();
+    constexpr Matrix4x4 identity();
+    constexpr void setToIdentity();
 
     bool inverse();
+    constexpr bool inverseAffine();     //Bottom row must be 0, 0, 0, 1
+    constexpr void inverseRigid();      //Rotation and translation only
+    constexpr bool isAffine() const;
 
-    void translateX(GLfloat x = 0.f);
-    void translateY(GLfloat y = 0.f);
-    void translateZ(GLfloat z = 0.f);
+    constexpr void translateX(GLfloat x = 0.f);
+    constexpr void translateY(GLfloat y = 0.f);
+    constexpr void translateZ(GLfloat z = 0.f);
 
-    void setPosition(GLfloat x = 0.f, GLfloat y = 0.f, GLfloat z = 0.f);
-    gsl::Vector3D getPosition();
+    constexpr void setPosition(GLfloat x = 0.f, GLfloat y = 0.f, GLfloat z = 0.f);
+    constexpr gsl::Vector3D getPosition();
 
     //Rotate using EulerMatrix
     void rotateX(GLfloat degrees = 0.f);
     void rotateY(GLfloat degrees = 0.f);
     void rotateZ(GLfloat degrees = 0.f);
+    void rotate(const Quaternion &rotation);    //Defined in quaternion.h
 //    void rotate(GLfloat angle, Vector3D vector);
 //    void rotate(GLfloat angle, GLfloat xIn, GLfloat yIn, GLfloat zIn);
 
-    void scale(Vector3D s);
-    void scale(GLfloat uniformScale);
-    void scale(GLfloat scaleX, GLfloat scaleY, GLfloat scaleZ);
+    constexpr void scale(Vector3D s);
+    constexpr void scale(GLfloat uniformScale);
+    constexpr void scale(GLfloat scaleX, GLfloat scaleY, GLfloat scaleZ);
 
-    GLfloat* constData();
+    constexpr GLfloat* constData();
+    constexpr const GLfloat* constData() const;
 
-    void transpose();
+    constexpr void transpose();
 
-    void ortho(GLfloat l, GLfloat r, GLfloat b, GLfloat t, GLfloat nearPlane, GLfloat farPlane);
-    void frustum(float left, float right, float bottom, float top, float nearPlane, float farPlane);
+    constexpr void ortho(GLfloat l, GLfloat r, GLfloat b, GLfloat t, GLfloat nearPlane, GLfloat farPlane);
+    constexpr void frustum(float left, float right, float bottom, float top, float nearPlane, float farPlane);
     void perspective(GLfloat fieldOfView, GLfloat aspectRatio, GLfloat nearPlane, GLfloat farPlane);
 
     void lookAt(const Vector3D &eye, const Vector3D &center, const Vector3D &up_axis);
 
     void setRotationToVector(const Vector3D &direction, Vector3D up = Vector3D(0.f,1.f,0.f));
 
-    void translate(GLfloat x = 0.f, GLfloat y = 0.f, GLfloat z = 0.f);
-    void translate(Vector3D positionIn);
+    constexpr void translate(GLfloat x = 0.f, GLfloat y = 0.f, GLfloat z = 0.f);
+    constexpr void translate(Vector3D positionIn);
 
-    Matrix2x2 toMatrix2();
+    Matrix2x2 toMatrix2() const;
     Matrix3x3 toMatrix3() const;
 
-    GLfloat& operator()(const int &y, const int &x);
-    GLfloat operator()(const int &y, const int &x) const;
+    constexpr GLfloat& operator()(const int &y, const int &x);
+    constexpr GLfloat operator()(const int &y, const int &x) const;
 
-    Matrix4x4 operator*(const Matrix4x4 &other);
+    Matrix4x4 operator*(const Matrix4x4 &other) const;
 
-    Vector4D operator*(const Vector4D &other);
+    Vector4D operator*(const Vector4D &other) const;
 
     friend std::ostream& operator<<(std::ostream &output, const Matrix4x4 &mIn)
     {
@@ -75,11 +97,551 @@ public:
                   "{" << mIn.matrix[3] << "\t, " << mIn.matrix[7] << "\t, " << mIn.matrix[11] << "\t, " << mIn.matrix[15] << "}\n";
         return output;
     }
-    GLfloat getFloat(int space);
+    constexpr GLfloat getFloat(int space);
 private:
+    constexpr void swapElements(int a, int b)
+    {
+        GLfloat temp = matrix[a];
+        matrix[a] = matrix[b];
+        matrix[b] = temp;
+    }
+
     GLfloat matrix[16];
 };
 
+static_assert(std::is_trivially_copyable<Matrix4x4>::value, "Matrix4x4 must be trivially copyable");
+static_assert(sizeof(Matrix4x4) == 16 * sizeof(GLfloat), "Matrix4x4 must be 16 packed floats, it is uploaded directly to OpenGL");
+
+constexpr Matrix4x4 Matrix4x4::identity()
+{
+    setToIdentity();
+
+    return *this;
+}
+
+constexpr void Matrix4x4::setToIdentity()
+{
+    for(int i = 0; i < 16; i++)
+        matrix[i] = (i % 5 == 0) ? 1.f : 0.f;
+}
+
+inline bool Matrix4x4::inverse()
+{
+    //Most matrices we invert are model matrices, which have a much cheaper inverse
+    if (isAffine())
+        return inverseAffine();
+
+    GLfloat inv[16]{}, det;
+
+    int i{0};
+
+    inv[0] = matrix[5]  * matrix[10] * matrix[15] -
+            matrix[5]  * matrix[11] * matrix[14] -
+            matrix[9]  * matrix[6]  * matrix[15] +
+            matrix[9]  * matrix[7]  * matrix[14] +
+            matrix[13] * matrix[6]  * matrix[11] -
+            matrix[13] * matrix[7]  * matrix[10];
+
+    inv[4] = -matrix[4]  * matrix[10] * matrix[15] +
+            matrix[4]  * matrix[11] * matrix[14] +
+            matrix[8]  * matrix[6]  * matrix[15] -
+            matrix[8]  * matrix[7]  * matrix[14] -
+            matrix[12] * matrix[6]  * matrix[11] +
+            matrix[12] * matrix[7]  * matrix[10];
+
+    inv[8] = matrix[4]  * matrix[9] * matrix[15] -
+            matrix[4]  * matrix[11] * matrix[13] -
+            matrix[8]  * matrix[5] * matrix[15] +
+            matrix[8]  * matrix[7] * matrix[13] +
+            matrix[12] * matrix[5] * matrix[11] -
+            matrix[12] * matrix[7] * matrix[9];
+
+    inv[12] = -matrix[4]  * matrix[9] * matrix[14] +
+            matrix[4]  * matrix[10] * matrix[13] +
+            matrix[8]  * matrix[5] * matrix[14] -
+            matrix[8]  * matrix[6] * matrix[13] -
+            matrix[12] * matrix[5] * matrix[10] +
+            matrix[12] * matrix[6] * matrix[9];
+
+    inv[1] = -matrix[1]  * matrix[10] * matrix[15] +
+            matrix[1]  * matrix[11] * matrix[14] +
+            matrix[9]  * matrix[2] * matrix[15] -
+            matrix[9]  * matrix[3] * matrix[14] -
+            matrix[13] * matrix[2] * matrix[11] +
+            matrix[13] * matrix[3] * matrix[10];
+
+    inv[5] = matrix[0]  * matrix[10] * matrix[15] -
+            matrix[0]  * matrix[11] * matrix[14] -
+            matrix[8]  * matrix[2] * matrix[15] +
+            matrix[8]  * matrix[3] * matrix[14] +
+            matrix[12] * matrix[2] * matrix[11] -
+            matrix[12] * matrix[3] * matrix[10];
+
+    inv[9] = -matrix[0]  * matrix[9] * matrix[15] +
+            matrix[0]  * matrix[11] * matrix[13] +
+            matrix[8]  * matrix[1] * matrix[15] -
+            matrix[8]  * matrix[3] * matrix[13] -
+            matrix[12] * matrix[1] * matrix[11] +
+            matrix[12] * matrix[3] * matrix[9];
+
+    inv[13] = matrix[0]  * matrix[9] * matrix[14] -
+            matrix[0]  * matrix[10] * matrix[13] -
+            matrix[8]  * matrix[1] * matrix[14] +
+            matrix[8]  * matrix[2] * matrix[13] +
+            matrix[12] * matrix[1] * matrix[10] -
+            matrix[12] * matrix[2] * matrix[9];
+
+    inv[2] = matrix[1]  * matrix[6] * matrix[15] -
+            matrix[1]  * matrix[7] * matrix[14] -
+            matrix[5]  * matrix[2] * matrix[15] +
+            matrix[5]  * matrix[3] * matrix[14] +
+            matrix[13] * matrix[2] * matrix[7] -
+            matrix[13] * matrix[3] * matrix[6];
+
+    inv[6] = -matrix[0]  * matrix[6] * matrix[15] +
+            matrix[0]  * matrix[7] * matrix[14] +
+            matrix[4]  * matrix[2] * matrix[15] -
+            matrix[4]  * matrix[3] * matrix[14] -
+            matrix[12] * matrix[2] * matrix[7] +
+            matrix[12] * matrix[3] * matrix[6];
+
+    inv[10] = matrix[0]  * matrix[5] * matrix[15] -
+            matrix[0]  * matrix[7] * matrix[13] -
+            matrix[4]  * matrix[1] * matrix[15] +
+            matrix[4]  * matrix[3] * matrix[13] +
+            matrix[12] * matrix[1] * matrix[7] -
+            matrix[12] * matrix[3] * matrix[5];
+
+    inv[14] = -matrix[0]  * matrix[5] * matrix[14] +
+            matrix[0]  * matrix[6] * matrix[13] +
+            matrix[4]  * matrix[1] * matrix[14] -
+            matrix[4]  * matrix[2] * matrix[13] -
+            matrix[12] * matrix[1] * matrix[6] +
+            matrix[12] * matrix[2] * matrix[5];
+
+    inv[3] = -matrix[1] * matrix[6] * matrix[11] +
+            matrix[1] * matrix[7] * matrix[10] +
+            matrix[5] * matrix[2] * matrix[11] -
+            matrix[5] * matrix[3] * matrix[10] -
+            matrix[9] * matrix[2] * matrix[7] +
+            matrix[9] * matrix[3] * matrix[6];
+
+    inv[7] = matrix[0] * matrix[6] * matrix[11] -
+            matrix[0] * matrix[7] * matrix[10] -
+            matrix[4] * matrix[2] * matrix[11] +
+            matrix[4] * matrix[3] * matrix[10] +
+            matrix[8] * matrix[2] * matrix[7] -
+            matrix[8] * matrix[3] * matrix[6];
+
+    inv[11] = -matrix[0] * matrix[5] * matrix[11] +
+            matrix[0] * matrix[7] * matrix[9] +
+            matrix[4] * matrix[1] * matrix[11] -
+            matrix[4] * matrix[3] * matrix[9] -
+            matrix[8] * matrix[1] * matrix[7] +
+            matrix[8] * matrix[3] * matrix[5];
+
+    inv[15] = matrix[0] * matrix[5] * matrix[10] -
+            matrix[0] * matrix[6] * matrix[9] -
+            matrix[4] * matrix[1] * matrix[10] +
+            matrix[4] * matrix[2] * matrix[9] +
+            matrix[8] * matrix[1] * matrix[6] -
+            matrix[8] * matrix[2] * matrix[5];
+
+    det = matrix[0] * inv[0] + matrix[1] * inv[4] + matrix[2] * inv[8] + matrix[3] * inv[12];
+
+    if (det == 0.f)
+        return false;
+
+    det = 1.f / det;
+
+    for (i = 0; i < 16; i++)
+        matrix[i] = inv[i] * det;
+
+    return true;
+}
+
+//Only valid if the bottom row is 0, 0, 0, 1 (translation, rotation, scale and shear).
+//The inverse of [A t] is [inverse(A) -inverse(A)*t], so only the 3x3 part needs a real inverse.
+constexpr bool Matrix4x4::inverseAffine()
+{
+    GLfloat a = matrix[0], b = matrix[1], c = matrix[2],
+            d = matrix[4], e = matrix[5], f = matrix[6],
+            g = matrix[8], h = matrix[9], i = matrix[10];
+
+    GLfloat A =  (e*i-f*h), B = -(d*i-f*g), C =  (d*h-e*g);
+
+    GLfloat det = a*A + b*B + c*C;
+
+    if (det == 0.f)
+        return false;
+
+    det = 1.f / det;
+
+    GLfloat inv[9] =
+    {
+        det*A, det*-(b*i-c*h), det*(b*f-c*e),
+        det*B, det*(a*i-c*g),  det*-(a*f-c*d),
+        det*C, det*-(a*h-b*g), det*(a*e-b*d)
+    };
+
+    GLfloat x = matrix[3], y = matrix[7], z = matrix[11];
+
+    for (int row = 0; row < 3; row++)
+    {
+        matrix[row * 4] = inv[row * 3];
+        matrix[row * 4 + 1] = inv[row * 3 + 1];
+        matrix[row * 4 + 2] = inv[row * 3 + 2];
+        matrix[row * 4 + 3] = -(inv[row * 3] * x + inv[row * 3 + 1] * y + inv[row * 3 + 2] * z);
+    }
+
+    return true;
+}
+
+//Only valid for rotation + translation (no scale).
+//The rotation is orthonormal, so its inverse is just the transpose.
+constexpr void Matrix4x4::inverseRigid()
+{
+    swapElements(1, 4);
+    swapElements(2, 8);
+    swapElements(6, 9);
+
+    GLfloat x = matrix[3], y = matrix[7], z = matrix[11];
+
+    matrix[3] = -(matrix[0] * x + matrix[1] * y + matrix[2] * z);
+    matrix[7] = -(matrix[4] * x + matrix[5] * y + matrix[6] * z);
+    matrix[11] = -(matrix[8] * x + matrix[9] * y + matrix[10] * z);
+}
+
+constexpr bool Matrix4x4::isAffine() const
+{
+    return matrix[12] == 0.f && matrix[13] == 0.f && matrix[14] == 0.f && matrix[15] == 1.f;
+}
+
+constexpr void Matrix4x4::translateX(GLfloat x)
+{
+    translate(x, 0.f, 0.f);
+}
+
+constexpr void Matrix4x4::translateY(GLfloat y)
+{
+    translate(0.f, y, 0.f);
+}
+
+
+constexpr void Matrix4x4::translateZ(GLfloat z)
+{
+    translate(0.f, 0.f, z);
+}
+
+constexpr void Matrix4x4::setPosition(GLfloat x, GLfloat y, GLfloat z)
+{
+    matrix[3] = x;
+    matrix[7] = y;
+    matrix[11] = z;
+}
+
+constexpr Vector3D Matrix4x4::getPosition()
+{
+    return gsl::Vector3D(matrix[3], matrix[7], matrix[11]);
+}
+
+//The transforms below post-multiply with a translation, rotation or scale matrix.
+//Those only differ from identity in a few columns, so instead of building the
+//full matrix and doing a general multiply, only the affected columns are updated in place.
+
+inline void Matrix4x4::rotateX(GLfloat degrees)
+{
+    GLfloat s, c;
+    sincosDegrees(degrees, s, c);
+
+    //column1 = c*column1 - s*column2, column2 = s*column1 + c*column2
+    for(int y = 0; y < 4; y++)
+    {
+        GLfloat col1 = matrix[y * 4 + 1];
+        GLfloat col2 = matrix[y * 4 + 2];
+        matrix[y * 4 + 1] = col1 * c - col2 * s;
+        matrix[y * 4 + 2] = col1 * s + col2 * c;
+    }
+}
+
+inline void Matrix4x4::rotateY(GLfloat degrees)
+{
+    GLfloat s, c;
+    sincosDegrees(degrees, s, c);
+
+    //column0 = c*column0 + s*column2, column2 = -s*column0 + c*column2
+    for(int y = 0; y < 4; y++)
+    {
+        GLfloat col0 = matrix[y * 4];
+        GLfloat col2 = matrix[y * 4 + 2];
+        matrix[y * 4] = col0 * c + col2 * s;
+        matrix[y * 4 + 2] = col2 * c - col0 * s;
+    }
+}
+
+inline void Matrix4x4::rotateZ(GLfloat degrees)
+{
+    GLfloat s, c;
+    sincosDegrees(degrees, s, c);
+
+    //column0 = c*column0 - s*column1, column1 = s*column0 + c*column1
+    for(int y = 0; y < 4; y++)
+    {
+        GLfloat col0 = matrix[y * 4];
+        GLfloat col1 = matrix[y * 4 + 1];
+        matrix[y * 4] = col0 * c - col1 * s;
+        matrix[y * 4 + 1] = col0 * s + col1 * c;
+    }
+}
+
+// Rotate around a given vector
+//void Matrix4x4::rotate(GLfloat angle, Vector3D vector)
+//{
+//    vector.normalize();
+
+    //    https://learnopengl.com/Getting-started/Transformations
+    //    cosθ+Rx2(1−cosθ)      RxRy(1−cosθ)−Rzsinθ     RxRz(1−cosθ)+Rysinθ     0
+    //    RyRx(1−cosθ)+Rzsinθ   cosθ+Ry2(1−cosθ)        RyRz(1−cosθ)−Rxsinθ     0
+    //    RzRx(1−cosθ)−Rysinθ   RzRy(1−cosθ)+Rxsinθ     cosθ+Rz2(1−cosθ)        0
+    //    0                     0                       0                       1
+//}
+
+//void Matrix4x4::rotate(GLfloat angle, GLfloat xIn, GLfloat yIn, GLfloat zIn)
+//{
+//    rotate(angle, Vector3D(xIn, yIn, zIn));
+//}
+
+constexpr void Matrix4x4::scale(Vector3D s)
+{
+    scale(s.getX(), s.getY(), s.getZ());
+}
+
+constexpr void Matrix4x4::scale(GLfloat uniformScale)
+{
+    scale(uniformScale, uniformScale, uniformScale);
+}
+
+constexpr void Matrix4x4::scale(GLfloat scaleX, GLfloat scaleY, GLfloat scaleZ)
+{
+    for(int y = 0; y < 4; y++)
+    {
+        matrix[y * 4] *= scaleX;
+        matrix[y * 4 + 1] *= scaleY;
+        matrix[y * 4 + 2] *= scaleZ;
+    }
+}
+
+
+constexpr GLfloat *Matrix4x4::constData()
+{
+    return &matrix[0];
+}
+
+constexpr const GLfloat *Matrix4x4::constData() const
+{
+    return &matrix[0];
+}
+
+constexpr void Matrix4x4::transpose()
+{
+    swapElements(1, 4);
+    swapElements(2, 8);
+    swapElements(3, 12);
+
+    swapElements(6, 9);
+    swapElements(7, 13);
+    swapElements(11, 14);
+}
+
+constexpr void Matrix4x4::ortho(GLfloat l, GLfloat r, GLfloat b, GLfloat t, GLfloat nearPlane, GLfloat farPlane)
+{
+    *this =
+    {
+        2.f/(r-l), 0.f, 0.f, 0.f,
+                0.f, 2.f/(t-b), 0.f, 0.f,
+                0.f, 0.f, -2.f/(farPlane-nearPlane), 0.f,
+                -(r+l)/(r-l), -(t+b)/(t-b), -(farPlane+nearPlane)/(farPlane-nearPlane), 1.f
+    };
+}
+
+//From Interactive Computer Graphics ch. 5
+constexpr void Matrix4x4::frustum(float left, float right, float bottom, float top, float nearPlane, float farPlane)
+{
+    *this =
+    {
+        2*nearPlane/(right-left),    0.f,                    (right+left)/(right-left),                      0.f,
+                0.f,              2*nearPlane/(top-bottom),  (top+bottom)/(top-bottom),                      0.f,
+                0.f,                 0.f,                    -(farPlane+nearPlane)/(farPlane-nearPlane),    -2*farPlane*nearPlane/(farPlane-nearPlane),
+                0.f,                 0.f,                               -1.0f,                               0.0f
+    };
+}
+
+inline void Matrix4x4::perspective(GLfloat fieldOfView, GLfloat aspectRatio, GLfloat nearPlane, GLfloat farPlane)
+{
+    /* General form of the Projection Matrix
+    //
+    // uh = Cot( fov/2 ) == 1/Tan(fov/2)
+    // uw / uh = 1/aspect
+    //
+    //   uw         0       0       0
+    //    0        uh       0       0
+    //    0         0      f/(f-n)  1
+    //    0         0    -fn/(f-n)  0 */
+
+    //Checking numbers for no division on zero:
+    if (fieldOfView <= 0.f)
+        fieldOfView = 30.f;
+    if (aspectRatio <= 0.f)
+        aspectRatio = 1.3f;
+    if (farPlane - nearPlane <= 0.f)
+    {
+        nearPlane = 1.f;
+        farPlane = 100.f;
+    }
+
+    GLfloat uh = static_cast<float>(1/std::tan(static_cast<double>(fieldOfView)/2 * (PI_D / 180.0)));
+    GLfloat uw = (1/aspectRatio) * uh;
+
+    *this =
+    {
+        uw,     0.f,    0.f,                                        0.f,
+        0.f,    uh,     0.f,                                        0.f,
+        0.f,    0.f,    -(farPlane)/(farPlane-nearPlane),    -2 * farPlane*nearPlane/(farPlane-nearPlane),
+        0.f,    0.f,    -1.f,                                        0.f
+    };
+
+
+
+    /*
+           //fieldOfView = verticalAngle
+           //Find right, and calculate the rest from there
+            GLfloat scale = std::tan(verticalAngle * PI / 360.f) * nearPlane;
+            GLfloat r = aspectRatio * scale;
+            GLfloat t = scale;
+
+            //Create perspective-frustrum
+            *this =
+            {
+                nearPlane/r, 0.f, 0.f, 0.f,
+                0.f, nearPlane/t, 0.f, 0.f,
+                0.f, 0.f, -(farPlane+nearPlane)/(farPlane-nearPlane), -2*farPlane*nearPlane/(farPlane-nearPlane),
+                0.f, 0.f, -1.f, 0.f
+            };
+    */
+}
+
+inline void Matrix4x4::lookAt(const Vector3D &eye, const Vector3D &center, const Vector3D &up_axis)
+{
+    Vector3D f = center-eye;    //forward
+    f.normalize();
+    Vector3D s = Vector3D::cross(f, up_axis);   //sideways
+    s.normalize();
+    Vector3D u = Vector3D::cross(s, f);     //up
+
+    *this =
+    {
+        s.getX(),  s.getY(),  s.getZ(), -Vector3D::dot(s, eye),
+                u.getX(),  u.getY(),  u.getZ(), -Vector3D::dot(u, eye),
+                -f.getX(), -f.getY(), -f.getZ(), Vector3D::dot(f, eye),
+                0.f, 0.f, 0.f, 1.f
+    };
+}
+
+inline void Matrix4x4::setRotationToVector(const Vector3D &direction, Vector3D up)
+{
+    Vector3D xaxis = Vector3D::cross(up, direction);
+    xaxis.normalize();
+
+    Vector3D yaxis = Vector3D::cross(direction, xaxis);
+    yaxis.normalize();
+
+    matrix[0] = xaxis.x;
+    matrix[1] = yaxis.x;
+    matrix[2] = direction.x;
+
+    matrix[4] = xaxis.y;
+    matrix[5] = yaxis.y;
+    matrix[6] = direction.y;
+
+    matrix[8] = xaxis.z;
+    matrix[9] = yaxis.z;
+    matrix[10] = direction.z;
+}
+
+constexpr void Matrix4x4::translate(GLfloat x, GLfloat y, GLfloat z)
+{
+    //Only the last column changes: column3 += column0*x + column1*y + column2*z
+    for(int row = 0; row < 4; row++)
+    {
+        GLfloat *r = &matrix[row * 4];
+        r[3] += r[0] * x + r[1] * y + r[2] * z;
+    }
+}
+
+constexpr void Matrix4x4::translate(Vector3D positionIn)
+{
+    translate(positionIn.getX(), positionIn.getY(), positionIn.getZ());
+}
+
+constexpr GLfloat& Matrix4x4::operator()(const int &y, const int &x)
+{
+    return matrix[y * 4 + x];
+}
+
+constexpr GLfloat Matrix4x4::operator()(const int &y, const int &x) const
+{
+    return matrix[y * 4 + x];
+}
+
+inline Matrix4x4 Matrix4x4::operator*(const Matrix4x4 &other) const
+{
+    //Goes through the SSE/AVX kernels when the CPU supports them
+    Matrix4x4 result;
+    simd::multiplyMatrix4x4(matrix, other.matrix, result.matrix);
+    return result;
+}
+
+constexpr GLfloat Matrix4x4::getFloat(int space)
+{
+    return matrix[space];
+}
+
+inline Vector4D Matrix4x4::operator*(const Vector4D &v) const
+{
+    GLfloat in[4] = {v.getX(), v.getY(), v.getZ(), v.getW()};
+    GLfloat out[4];
+    simd::multiplyMatrix4x4Vector4(matrix, in, out);
+    return Vector4D(out[0], out[1], out[2], out[3]);
+}
+
+} //namespace
+
+//The other matrix types are needed to define the conversions
+#include "matrix2x2.h"
+#include "matrix3x3.h"
+
+namespace gsl
+{
+
+inline Matrix2x2 Matrix4x4::toMatrix2() const
+{
+    return Matrix2x2
+    {
+        matrix[0], matrix[1],
+        matrix[4], matrix[5]
+    };
+}
+
+inline Matrix3x3 Matrix4x4::toMatrix3() const
+{
+    return Matrix3x3
+    {
+        matrix[0], matrix[1], matrix[2],
+        matrix[4], matrix[5], matrix[6],
+        matrix[8], matrix[9], matrix[10]
+    };
+}
+
 } //namespace
 
 #endif // MATRIX4X4_H
@@ -0,0 +1,184 @@
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include "vector3d.h"
+#include "matrix3x3.h"
+#include "matrix4x4.h"
+#include "math_constants.h"
+#include "fastmath.h"
+#include "gltypes.h"
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+namespace gsl
+{
+
+//Unit quaternions are used for orientations: rotating a vector, composing rotations
+//and interpolating between them is cheaper and more stable than with Euler angles and matrices.
+//Rotations follow the right hand rule, the same as Vector3D::rotateX/Y/Z.
+class Quaternion
+{
+public:
+    //Constructors - the default is the identity rotation
+    constexpr Quaternion(GLfloat w_in = 1.f, GLfloat x_in = 0.f, GLfloat y_in = 0.f, GLfloat z_in = 0.f)
+        : w{w_in}, x{x_in}, y{y_in}, z{z_in} {}
+
+    //axis must be normalized
+    static Quaternion fromAxisAngle(const Vector3D &axis, GLfloat degrees)
+    {
+        GLfloat s, c;
+        sincosDegrees(degrees * 0.5f, s, c);
+        return {c, axis.x * s, axis.y * s, axis.z * s};
+    }
+
+    //Operators
+    constexpr Quaternion operator*(const Quaternion &rhs) const     // q * q - rhs is applied first
+    {
+        return {w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z,
+                w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+                w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+                w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w};
+    }
+    constexpr Quaternion operator+(const Quaternion &rhs) const     // q + q
+    {
+        return {w + rhs.w, x + rhs.x, y + rhs.y, z + rhs.z};
+    }
+    constexpr Quaternion operator*(GLfloat rhs) const               // q * f
+    {
+        return {w * rhs, x * rhs, y * rhs, z * rhs};
+    }
+    constexpr Quaternion operator-() const                          // -q, same rotation
+    {
+        return {-w, -x, -y, -z};
+    }
+
+    //Functions
+    //The inverse rotation, for unit quaternions
+    constexpr Quaternion conjugate() const
+    {
+        return {w, -x, -y, -z};
+    }
+    static constexpr GLfloat dot(const Quaternion &q1, const Quaternion &q2)
+    {
+        return q1.w * q2.w + q1.x * q2.x + q1.y * q2.y + q1.z * q2.z;
+    }
+    GLfloat length() const
+    {
+        return std::sqrt(dot(*this, *this));
+    }
+    //Call now and then when composing many rotations, so rounding errors don't build up
+    void normalize()
+    {
+        GLfloat l = length();
+
+        if (l > 0.f)
+        {
+            GLfloat inv = 1.f / l;
+            w *= inv;
+            x *= inv;
+            y *= inv;
+            z *= inv;
+        }
+    }
+    Quaternion normalized() const
+    {
+        Quaternion normalized{*this};
+        normalized.normalize();
+        return normalized;
+    }
+
+    //Same as q * v * conjugate(q), but expanded to two cross products
+    constexpr Vector3D rotate(const Vector3D &v) const
+    {
+        Vector3D u{x, y, z};
+        Vector3D t = Vector3D::cross(u, v) * 2.f;
+        return v + t * w + Vector3D::cross(u, t);
+    }
+
+    constexpr Matrix3x3 toMatrix3() const
+    {
+        GLfloat xx = x * x, yy = y * y, zz = z * z;
+        GLfloat xy = x * y, xz = x * z, yz = y * z;
+        GLfloat wx = w * x, wy = w * y, wz = w * z;
+
+        return
+        {
+            1.f - 2.f * (yy + zz),  2.f * (xy - wz),        2.f * (xz + wy),
+            2.f * (xy + wz),        1.f - 2.f * (xx + zz),  2.f * (yz - wx),
+            2.f * (xz - wy),        2.f * (yz + wx),        1.f - 2.f * (xx + yy)
+        };
+    }
+
+    constexpr Matrix4x4 toMatrix4() const
+    {
+        Matrix3x3 r = toMatrix3();
+
+        return
+        {
+            r(0, 0), r(0, 1), r(0, 2), 0.f,
+            r(1, 0), r(1, 1), r(1, 2), 0.f,
+            r(2, 0), r(2, 1), r(2, 2), 0.f,
+            0.f,     0.f,     0.f,     1.f
+        };
+    }
+
+    //Interpolation - t from 0 to 1. Both take the shortest way around.
+    //nlerp is cheaper, but does not move at constant angular speed. Good enough for small steps.
+    static Quaternion nlerp(const Quaternion &start, const Quaternion &end, GLfloat t)
+    {
+        Quaternion target = dot(start, end) < 0.f ? -end : end;
+        return (start * (1.f - t) + target * t).normalized();
+    }
+    static Quaternion slerp(const Quaternion &start, const Quaternion &end, GLfloat t)
+    {
+        GLfloat cosAngle = dot(start, end);
+        Quaternion target = end;
+        if (cosAngle < 0.f)
+        {
+            cosAngle = -cosAngle;
+            target = -end;
+        }
+
+        //Almost the same rotation - sin(angle) goes towards 0, so fall back to nlerp
+        if (cosAngle > 0.9995f)
+            return nlerp(start, target, t);
+
+        GLfloat angle = std::acos(cosAngle);
+        GLfloat invSin = 1.f / std::sin(angle);
+        return start * (std::sin((1.f - t) * angle) * invSin) + target * (std::sin(t * angle) * invSin);
+    }
+
+    //Friend functions
+    friend std::ostream& operator<<(std::ostream &output, const Quaternion &rhs)
+    {
+        output << "W = " << rhs.w << ", X = " << rhs.x << ", Y = " << rhs.y << ", Z = " << rhs.z;
+        return output;
+    }
+
+    GLfloat w;
+    GLfloat x;
+    GLfloat y;
+    GLfloat z;
+};
+
+static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion must be trivially copyable");
+
+//Post-multiplies with the rotation of q, like rotateX/Y/Z. Only the 3x3 part of each row changes.
+//Defined here since Matrix4x4 only knows Quaternion as a forward declaration.
+inline void Matrix4x4::rotate(const Quaternion &q)
+{
+    Matrix3x3 r = q.toMatrix3();
+
+    for (int y = 0; y < 4; y++)
+    {
+        GLfloat a = matrix[y * 4], b = matrix[y * 4 + 1], c = matrix[y * 4 + 2];
+        matrix[y * 4]     = a * r(0, 0) + b * r(1, 0) + c * r(2, 0);
+        matrix[y * 4 + 1] = a * r(0, 1) + b * r(1, 1) + c * r(2, 1);
+        matrix[y * 4 + 2] = a * r(0, 2) + b * r(1, 2) + c * r(2, 2);
+    }
+}
+
+} //namespace
+
+#endif // QUATERNION_H
@@ -4,6 +4,7 @@
 #include "gltypes.h"
 #include <cmath>
 #include <iostream>
+#include <type_traits>
 
 namespace gsl
 {
@@ -12,32 +13,77 @@ class Vector2D
 {
 public:
     //Constructors
-    Vector2D(GLfloat x_in = 0.f, GLfloat y_in = 0.f);
-    Vector2D(const int v);
-    Vector2D(const double v);
+    constexpr Vector2D(GLfloat x_in = 0.f, GLfloat y_in = 0.f) : x{x_in}, y{y_in} {}
+    constexpr Vector2D(const int v) : x{static_cast<GLfloat>(v)}, y{static_cast<GLfloat>(v)} {}
+    constexpr Vector2D(const double v) : x{static_cast<GLfloat>(v)}, y{static_cast<GLfloat>(v)} {}
 
     //Operators
-    Vector2D operator+(const Vector2D &rhs) const;      // v + v
-    Vector2D operator-(const Vector2D &rhs) const;      // v - v
-    Vector2D& operator+=(const Vector2D &rhs);          // v += v
-    Vector2D& operator-=(const Vector2D &rhs);          // v -= v
-    Vector2D operator-() const;                     // -v
-    Vector2D operator*(GLfloat lhs) const;          // v * f
-    const Vector2D& operator =(const Vector2D &rhs);    // v = v
+    constexpr Vector2D operator+(const Vector2D &rhs) const     // v + v
+    {
+        return {x + rhs.x, y + rhs.y};
+    }
+    constexpr Vector2D operator-(const Vector2D &rhs) const     // v - v
+    {
+        return {x - rhs.x, y - rhs.y};
+    }
+    constexpr Vector2D& operator+=(const Vector2D &rhs)         // v += v
+    {
+        x += rhs.x;
+        y += rhs.y;
+        return *this;
+    }
+    constexpr Vector2D& operator-=(const Vector2D &rhs)         // v -= v
+    {
+        x -= rhs.x;
+        y -= rhs.y;
+        return *this;
+    }
+    constexpr Vector2D operator-() const                    // -v
+    {
+        return {-x, -y};
+    }
+    constexpr Vector2D operator*(GLfloat lhs) const         // v * f
+    {
+        return {x * lhs, y * lhs};
+    }
 
     //Functions
-    GLfloat length() const;
-    void normalize();
-    Vector2D normalized();
-    static GLfloat cross(const Vector2D &v1, const Vector2D &v2);
-    static GLfloat dot(const Vector2D &v1, const Vector2D &v2);
+    GLfloat length() const
+    {
+        return std::sqrt(x * x + y * y);
+    }
+    void normalize()
+    {
+        GLfloat l = length();
+
+        if (l > 0.f)
+        {
+            GLfloat inverseLength = 1.f / l;
+            x *= inverseLength;
+            y *= inverseLength;
+        }
+    }
+    Vector2D normalized() const
+    {
+        Vector2D normalized{*this};
+        normalized.normalize();
+        return normalized;
+    }
+    static GLfloat cross(const Vector2D &v1, const Vector2D &v2)
+    {
+        return std::abs((v1.x * v2.y) - (v1.y * v2.x));
+    }
+    static constexpr GLfloat dot(const Vector2D &v1, const Vector2D &v2)
+    {
+        return ((v1.x * v2.x) + (v1.y * v2.y));
+    }
 
     //Getters and setters
-    GLfloat getX() const;
-    void setX(const GLfloat &value);
+    constexpr GLfloat getX() const { return x; }
+    constexpr void setX(const GLfloat &value) { x = value; }
 
-    GLfloat getY() const;
-    void setY(const GLfloat &value);
+    constexpr GLfloat getY() const { return y; }
+    constexpr void setY(const GLfloat &value) { y = value; }
 
     //Friend functions
     friend std::ostream& operator<<(std::ostream &output, const Vector2D &rhs)
@@ -50,6 +96,9 @@ public:
     GLfloat y;
 };
 
+static_assert(std::is_trivially_copyable<Vector2D>::value, "Vector2D must be trivially copyable");
+static_assert(sizeof(Vector2D) == 2 * sizeof(GLfloat), "Vector2D must be two packed floats");
+
 } //namespace
 
 #endif // VECTOR2D_H
@@ -2,8 +2,11 @@
 #define VECTOR3D_H
 
 #include "gltypes.h"
+#include "math_constants.h"
+#include "fastmath.h"
 #include <cmath>
 #include <iostream>
+#include <type_traits>
 #include <QDebug>
 #include <QVector3D>
 
@@ -14,44 +17,121 @@ class Vector3D
 {
 public:
     //Constructors
-    Vector3D(GLfloat x_in = 0.f, GLfloat y_in = 0.f, GLfloat z_in = 0.f);
-    Vector3D(const int v);
-    Vector3D(const double v);
+    constexpr Vector3D(GLfloat x_in = 0.f, GLfloat y_in = 0.f, GLfloat z_in = 0.f) : x{x_in}, y{y_in}, z{z_in} {}
+    constexpr Vector3D(const int v) : x{static_cast<float>(v)}, y{static_cast<float>(v)}, z{static_cast<float>(v)} {}
+    constexpr Vector3D(const double v) : x{static_cast<float>(v)}, y{static_cast<float>(v)}, z{static_cast<float>(v)} {}
 
     //Operators
-    const Vector3D& operator=(const Vector3D &rhs);     // v = v
-    Vector3D operator+(const Vector3D &rhs) const;      // v + v
-    Vector3D operator-(const Vector3D &rhs) const;      // v - v
-    Vector3D& operator+=(const Vector3D &rhs);          // v += v
-    Vector3D& operator-=(const Vector3D &rhs);          // v -= v
-    Vector3D operator-() const;                     // -v
-    Vector3D operator*(GLfloat rhs) const;          // v * f
-    Vector3D operator^(const Vector3D& rhs) const; // v x v  - cross product
+    constexpr Vector3D operator+(const Vector3D &rhs) const     // v + v
+    {
+        return {x + rhs.x, y + rhs.y, z + rhs.z};
+    }
+    constexpr Vector3D operator-(const Vector3D &rhs) const     // v - v
+    {
+        return {x - rhs.x, y - rhs.y, z - rhs.z};
+    }
+    constexpr Vector3D& operator+=(const Vector3D &rhs)         // v += v
+    {
+        x += rhs.x;
+        y += rhs.y;
+        z += rhs.z;
+        return *this;
+    }
+    constexpr Vector3D& operator-=(const Vector3D &rhs)         // v -= v
+    {
+        x -= rhs.x;
+        y -= rhs.y;
+        z -= rhs.z;
+        return *this;
+    }
+    constexpr Vector3D operator-() const                    // -v
+    {
+        return {-x, -y, -z};
+    }
+    constexpr Vector3D operator*(GLfloat rhs) const         // v * f
+    {
+        return {x * rhs, y * rhs, z * rhs};
+    }
+    constexpr Vector3D operator^(const Vector3D& rhs) const // v x v  - cross product
+    {
+        return cross(*this, rhs);
+    }
 
     //Functions
-    GLfloat length() const;
-    void normalize();
-    Vector3D normalized();
-    static Vector3D cross(const Vector3D &v1, const Vector3D &v2);
-    static GLfloat dot(const Vector3D &v1, const Vector3D &v2);
+    GLfloat length() const
+    {
+        return std::sqrt(x * x + y * y + z * z);
+    }
+    void normalize()
+    {
+        GLfloat l = length();
+
+        if (l > 0.f)
+        {
+            //One divide instead of three
+            GLfloat inverseLength = 1.f / l;
+            x *= inverseLength;
+            y *= inverseLength;
+            z *= inverseLength;
+        }
+    }
+    Vector3D normalized() const
+    {
+        Vector3D normalized{*this};
+        normalized.normalize();
+        return normalized;
+    }
+    static constexpr Vector3D cross(const Vector3D &v1, const Vector3D &v2)
+    {
+        return {((v1.y * v2.z) - (v1.z * v2.y)), ((v1.z * v2.x) - (v1.x * v2.z)), ((v1.x * v2.y) - (v1.y * v2.x))};
+    }
+    static constexpr GLfloat dot(const Vector3D &v1, const Vector3D &v2)
+    {
+        return ((v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z));
+    }
 
-    void rotateX(GLfloat angle);
-    void rotateY(GLfloat angle);
-    void rotateZ(GLfloat angle);
+    //Angles in degrees
+    void rotateX(GLfloat angle)
+    {
+        GLfloat s, c;
+        sincosDegrees(angle, s, c);
+
+        GLfloat newY = (y * c) + (z * -s);
+        z = (y * s) + (z * c);
+        y = newY;
+    }
+    void rotateY(GLfloat angle)
+    {
+        GLfloat s, c;
+        sincosDegrees(angle, s, c);
+
+        GLfloat newX = (x * c) + (z * s);
+        z = (x * -s) + (z * c);
+        x = newX;
+    }
+    void rotateZ(GLfloat angle)
+    {
+        GLfloat s, c;
+        sincosDegrees(angle, s, c);
+
+        GLfloat newX = (x * c) + (y * -s);
+        y = (x * s) + (y * c);
+        x = newX;
+    }
 
     //Getters and setters
-    GLfloat getX() const;
-    void setX(const GLfloat &value);
+    constexpr GLfloat getX() const { return x; }
+    constexpr void setX(const GLfloat &value) { x = value; }
 
-    GLfloat getY() const;
-    void setY(const GLfloat &value);
+    constexpr GLfloat getY() const { return y; }
+    constexpr void setY(const GLfloat &value) { y = value; }
 
-    GLfloat getZ() const;
-    void setZ(const GLfloat &value);
+    constexpr GLfloat getZ() const { return z; }
+    constexpr void setZ(const GLfloat &value) { z = value; }
 
-    GLfloat *xP();
-    GLfloat *yP();
-    GLfloat *zP();
+    constexpr GLfloat *xP() { return &x; }
+    constexpr GLfloat *yP() { return &y; }
+    constexpr GLfloat *zP() { return &z; }
 
 
     //Friend functions
@@ -79,6 +159,9 @@ public:
     GLfloat z;
 };
 
+static_assert(std::is_trivially_copyable<Vector3D>::value, "Vector3D must be trivially copyable");
+static_assert(sizeof(Vector3D) == 3 * sizeof(GLfloat), "Vector3D must be three packed floats");
+
 } //namespace
 
 #endif // VECTOR3D_H
@@ -2,40 +2,80 @@
 #define VECTOR4D_H
 
 #include "gltypes.h"
+#include "vector3d.h"
 #include <cmath>
 #include <iostream>
 #include <cassert>
+#include <type_traits>
 
 namespace gsl
 {
 
-class Vector3D;
-
 class Vector4D
 {
 public:
     //Constructors
-    Vector4D(GLfloat x_in = 0.f, GLfloat y_in = 0.f, GLfloat z_in = 0.f, GLfloat w_in = 0.f);
-    Vector4D(Vector3D vec3_in, GLfloat w_in);
-    Vector4D(const Vector3D &vec3_in);
-    Vector4D(const int v);
-    Vector4D(const double v);
+    constexpr Vector4D(GLfloat x_in = 0.f, GLfloat y_in = 0.f, GLfloat z_in = 0.f, GLfloat w_in = 0.f)
+        : x{x_in}, y{y_in}, z{z_in}, w{w_in} {}
+    constexpr Vector4D(Vector3D vec3_in, GLfloat w_in) : x{vec3_in.x}, y{vec3_in.y}, z{vec3_in.z}, w{w_in} {}
+    constexpr Vector4D(const Vector3D &vec3_in) : x{vec3_in.x}, y{vec3_in.y}, z{vec3_in.z}, w{1.f} {}
+    constexpr Vector4D(const int v)
+        : x{static_cast<GLfloat>(v)}, y{static_cast<GLfloat>(v)}, z{static_cast<GLfloat>(v)}, w{1.f} {}
+    constexpr Vector4D(const double v)
+        : x{static_cast<GLfloat>(v)}, y{static_cast<GLfloat>(v)}, z{static_cast<GLfloat>(v)}, w{1.f} {}
 
     // divide x, y, z on w
-    void clipInvNormalize();
-    void clipNormalize();
+    constexpr void clipInvNormalize()
+    {
+        x /= w;
+        y /= w;
+        z /= w;
+        w = 1;
+    }
+    constexpr void clipNormalize()
+    {
+        w = 1/w;
+        x *= w;
+        y *= w;
+        z *= w;
+    }
 
     //Operators:
-    const Vector4D& operator=(const Vector4D &rhs);     // v = v
-    Vector4D operator+(const Vector4D &rhs) const;      // v + v
-    Vector4D operator-(const Vector4D &rhs) const;      // v - v
-    Vector4D& operator+=(const Vector4D &rhs);          // v += v
-    Vector4D& operator-=(const Vector4D &rhs);          // v -= v
-    Vector4D operator-() const;                     // -v
-    Vector4D operator*(GLfloat rhs) const;          // v * f
+    constexpr Vector4D operator+(const Vector4D &rhs) const     // v + v
+    {
+        return {x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w};
+    }
+    constexpr Vector4D operator-(const Vector4D &rhs) const     // v - v
+    {
+        return {x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w};
+    }
+    constexpr Vector4D& operator+=(const Vector4D &rhs)         // v += v
+    {
+        x += rhs.x;
+        y += rhs.y;
+        z += rhs.z;
+        w += rhs.w;
+        return *this;
+    }
+    constexpr Vector4D& operator-=(const Vector4D &rhs)         // v -= v
+    {
+        x -= rhs.x;
+        y -= rhs.y;
+        z -= rhs.z;
+        w -= rhs.w;
+        return *this;
+    }
+    constexpr Vector4D operator-() const                    // -v
+    {
+        return {-x, -y, -z, -w};
+    }
+    constexpr Vector4D operator*(GLfloat rhs) const         // v * f
+    {
+        return {x * rhs, y * rhs, z * rhs, w * rhs};
+    }
     //Vec4 operator*(Matrix4x4 q) const;        // v * m
 
-    GLfloat& operator[](const int index)
+    constexpr GLfloat& operator[](const int index)
     {
         assert(index <4 && index >=0);
 
@@ -53,30 +93,78 @@ public:
     }
 
     //Functions:
-    GLfloat length();
-    Vector3D toVector3D();
-    void normalize();
-    Vector4D normalized();
-    static GLfloat dot(const Vector4D &v1, const Vector4D &v2);
+    GLfloat length() const
+    {
+        return std::sqrt(x*x + y*y + z*z + w*w);
+    }
+    constexpr Vector3D toVector3D() const
+    {
+        return Vector3D(x, y, z);
+    }
+    void normalize()
+    {
+        GLfloat l = length();
+
+        if(l > 0.f)
+        {
+            GLfloat inverseLength = 1.f / l;
+            x *= inverseLength;
+            y *= inverseLength;
+            z *= inverseLength;
+            w *= inverseLength;
+        }
+    }
+    Vector4D normalized() const
+    {
+        Vector4D normalized{*this};
+        normalized.normalize();
+        return normalized;
+    }
+    static constexpr GLfloat dot(const Vector4D &v1, const Vector4D &v2)
+    {
+        return (v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z) + (v1.w * v2.w);
+    }
 
-    void rotateX(GLfloat angle);
-    void rotateY(GLfloat angle);
-    void rotateZ(GLfloat angle);
+    void rotateX(GLfloat angle)
+    {
+        Vector3D v = toVector3D();
+        v.rotateX(angle);
+        setXYZ(v);
+    }
+    void rotateY(GLfloat angle)
+    {
+        Vector3D v = toVector3D();
+        v.rotateY(angle);
+        setXYZ(v);
+    }
+    void rotateZ(GLfloat angle)
+    {
+        Vector3D v = toVector3D();
+        v.rotateZ(angle);
+        setXYZ(v);
+    }
 
     //Getters and setters
-    GLfloat getX() const;
-    void setX(const GLfloat &value);
+    constexpr GLfloat getX() const { return x; }
+    constexpr void setX(const GLfloat &value) { x = value; }
 
-    GLfloat getY() const;
-    void setY(const GLfloat &value);
+    constexpr GLfloat getY() const { return y; }
+    constexpr void setY(const GLfloat &value) { y = value; }
 
-    GLfloat getZ() const;
-    void setZ(const GLfloat &value);
+    constexpr GLfloat getZ() const { return z; }
+    constexpr void setZ(const GLfloat &value) { z = value; }
 
-    GLfloat getW() const;
-    void setW(const GLfloat &value);
+    constexpr GLfloat getW() const { return w; }
+    constexpr void setW(const GLfloat &value)
+    {
+        if (value == 0.f || value == 1.f)    //w should be only 0 or 1
+            w = value;
+    }
 
-    Vector3D getXYZ() const;
+    constexpr Vector3D getXYZ() const
+    {
+        return Vector3D(x, y, z);
+    }
 
     //Friend functions
     friend std::ostream& operator<<(std::ostream &output, const Vector4D &rhs )
@@ -91,8 +179,19 @@ public:
     GLfloat y;
     GLfloat z;
     GLfloat w;
+
+private:
+    constexpr void setXYZ(const Vector3D &v)
+    {
+        x = v.x;
+        y = v.y;
+        z = v.z;
+    }
 };
 
+static_assert(std::is_trivially_copyable<Vector4D>::value, "Vector4D must be trivially copyable");
+static_assert(sizeof(Vector4D) == 4 * sizeof(GLfloat), "Vector4D must be four packed floats");
+
 } //namespace
 
 #endif // VECTOR4D_H
@@ -7,54 +7,58 @@ TARGET      = INNgine2019
 
 PRECOMPILED_HEADER = innpch.h
 
-INCLUDEPATH +=  ./GSL
+include(GSL/gsl.pri)
 
 HEADERS += \
-    GSL/matrix2x2.h \
-    GSL/matrix3x3.h \
-    GSL/matrix4x4.h \
-    GSL/vector2d.h \
-    GSL/vector3d.h \
-    GSL/vector4d.h \
-    GSL/gsl_math.h \
-    GSL/math_constants.h \
     boat.h \
+    bounds.h \
     constants.h \
     renderwindow.h \
     shader.h \
     mainwindow.h \
     texture.h \
+    texturecache.h \
+    textureformat.h \
     vertex.h \
+    vertexformat.h \
     visualobject.h \
     camera.h \
     gltypes.h \
     input.h \
     material.h \
     objmesh.h \
+    objreader.h \
+    meshdata.h \
+    meshfile.h \
+    meshcache.h \
+    meshoptimizer.h \
+    meshsimplifier.h \
 #    innpch.h \
     colorshader.h \
     textureshader.h \
 
 
 SOURCES += main.cpp \
-    GSL/matrix2x2.cpp \
-    GSL/matrix3x3.cpp \
-    GSL/matrix4x4.cpp \
-    GSL/vector2d.cpp \
-    GSL/vector3d.cpp \
-    GSL/vector4d.cpp \
-    GSL/gsl_math.cpp \
     boat.cpp \
+    bounds.cpp \
     renderwindow.cpp \
     mainwindow.cpp \
     shader.cpp \
     texture.cpp \
+    texturecache.cpp \
+    textureformat.cpp \
     vertex.cpp \
+    vertexformat.cpp \
     visualobject.cpp \
     camera.cpp \
     input.cpp \
     material.cpp \
     objmesh.cpp \
+    objreader.cpp \
+    meshfile.cpp \
+    meshcache.cpp \
+    meshoptimizer.cpp \
+    meshsimplifier.cpp \
     colorshader.cpp \
     textureshader.cpp
 
@@ -66,5 +70,6 @@ DISTFILES += \
     Shaders/plainshader.vert \
     Shaders/textureshader.frag \
     GSL/README.md \
+    GSL/gsl.pri \
     README.md \
     Shaders/textureshader.vert
@@ -0,0 +1,139 @@
+#include "benchmark.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <cmath>
+#include <cstring>
+
+namespace bench
+{
+    Runner::Runner(const QString &filter, int repetitions, double minBatchMs)
+        : mFilter{filter}, mRepetitions{std::max(repetitions, 1)}, mMinBatchNs{minBatchMs * 1.0e6}
+    {
+    }
+
+    bool Runner::enabled(const QString &group, const QString &name) const
+    {
+        if (mFilter.isEmpty())
+            return true;
+
+        return QString("%1/%2").arg(group, name).contains(mFilter, Qt::CaseInsensitive);
+    }
+
+    void Runner::addInfo(const QString &key, const QString &value)
+    {
+        mInfo.push_back({key, value});
+    }
+
+    Result *Runner::store(const QString &group, const QString &name, const QString &variant,
+                          std::int64_t iterations, std::vector<double> &nsPerOp)
+    {
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+
+        Result result;
+        result.group = group;
+        result.name = name;
+        result.variant = variant;
+        result.iterations = iterations;
+        result.minNs = nsPerOp.front();
+        result.medianNs = nsPerOp[nsPerOp.size() / 2];
+
+        mResults.push_back(result);
+        return &mResults.back();
+    }
+
+    QString Runner::toJson() const
+    {
+        QJsonArray results;
+        for (const Result &result : mResults)
+        {
+            QJsonObject object;
+            object["group"] = result.group;
+            object["name"] = result.name;
+            if (!result.variant.isEmpty())
+                object["variant"] = result.variant;
+            object["iterations"] = static_cast<double>(result.iterations);
+            object["minNs"] = result.minNs;
+            object["medianNs"] = result.medianNs;
+            if (result.bytesPerOp > 0.0)
+                object["mbPerSecond"] = result.bytesPerOp / result.minNs * 1.0e3;
+            if (result.maxUlpError >= 0.0)
+                object["maxUlpError"] = result.maxUlpError;
+            results.append(object);
+        }
+
+        QJsonObject root;
+        for (const auto &info : mInfo)
+            root[info.first] = info.second;
+        root["results"] = results;
+        return QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    }
+
+    QString Runner::toCsv() const
+    {
+        QString csv;
+        QTextStream out(&csv);
+        out << "group,name,variant,iterations,min_ns,median_ns,mb_per_s,max_ulp_error\n";
+        for (const Result &result : mResults)
+        {
+            out << result.group << ',' << result.name << ',' << result.variant << ','
+                << result.iterations << ',' << result.minNs << ',' << result.medianNs << ',';
+            if (result.bytesPerOp > 0.0)
+                out << result.bytesPerOp / result.minNs * 1.0e3;
+            out << ',';
+            if (result.maxUlpError >= 0.0)
+                out << result.maxUlpError;
+            out << '\n';
+        }
+        out.flush();
+        return csv;
+    }
+
+    namespace
+    {
+        //Maps float bits to an integer line where neighbouring floats are 1 apart, also across 0
+        std::int64_t orderedBits(float value)
+        {
+            std::int32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits < 0 ? std::int64_t{INT32_MIN} - bits : bits;
+        }
+    }
+
+    double maxUlpDifference(const float *a, const float *b, std::size_t count)
+    {
+        double maxDifference = 0.0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (std::isnan(a[i]) || std::isnan(b[i]))
+            {
+                if (std::isnan(a[i]) != std::isnan(b[i]))
+                    return INFINITY;
+                continue;
+            }
+
+            std::int64_t difference = orderedBits(a[i]) - orderedBits(b[i]);
+            maxDifference = std::max(maxDifference, static_cast<double>(difference < 0 ? -difference : difference));
+        }
+        return maxDifference;
+    }
+
+    std::size_t firstBitDifference(const float *a, const float *b, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (std::memcmp(&a[i], &b[i], sizeof(float)) != 0)
+                return i;
+        }
+        return count;
+    }
+
+    double bitExactError(const float *a, const float *b, std::size_t count)
+    {
+        if (firstBitDifference(a, b, count) == count)
+            return 0.0;
+        return std::max(1.0, maxUlpDifference(a, b, count));
+    }
+
+} //namespace bench
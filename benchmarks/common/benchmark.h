@@ -0,0 +1,143 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+    //Stops the compiler from removing a calculation whose result is never used
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static const volatile void *sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result
+    {
+        QString group;
+        QString name;
+        QString variant;            //ex. instruction set, empty if only one version
+        std::int64_t iterations{0}; //per repetition
+        double minNs{0.0};          //per operation, best repetition
+        double medianNs{0.0};       //per operation
+        double bytesPerOp{0.0};     //set for throughput benchmarks, gives MB/s
+        double maxUlpError{-1.0};   //set when compared against a reference, -1 if not
+    };
+
+    //Runs each benchmark in batches long enough to time reliably, repeats the batch
+    //and keeps the best and median time per operation.
+    class Runner
+    {
+    public:
+        Runner(const QString &filter, int repetitions, double minBatchMs);
+
+        bool enabled(const QString &group, const QString &name) const;
+
+        //Extra key/value pairs written at the top of the JSON, ex. the CPU features
+        void addInfo(const QString &key, const QString &value);
+
+        //op is called once per operation with the iteration number, and should call doNotOptimize on its result.
+        //Returns the stored result so extra fields can be filled in (valid until the next run),
+        //or nullptr if the filter skipped it.
+        template <typename Op>
+        Result *run(const QString &group, const QString &name, Op &&op, const QString &variant = QString());
+
+        //For long operations (ex. parsing a whole file) that are timed one call at a time
+        template <typename Op>
+        Result *runOnce(const QString &group, const QString &name, Op &&op, const QString &variant = QString());
+
+        const QVector<Result> &results() const { return mResults; }
+
+        QString toJson() const;
+        QString toCsv() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        Result *store(const QString &group, const QString &name, const QString &variant,
+                      std::int64_t iterations, std::vector<double> &nsPerOp);
+
+        QString mFilter;
+        int mRepetitions;
+        double mMinBatchNs;
+        QVector<Result> mResults;
+        QVector<QPair<QString, QString>> mInfo;
+    };
+
+    template <typename Op>
+    Result *Runner::run(const QString &group, const QString &name, Op &&op, const QString &variant)
+    {
+        if (!enabled(group, name))
+            return nullptr;
+
+        //Double the batch until it takes long enough for the clock to be accurate
+        std::int64_t iterations = 1;
+        for (;;)
+        {
+            auto start = Clock::now();
+            for (std::int64_t i = 0; i < iterations; i++)
+                op(i);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+            if (ns >= mMinBatchNs || iterations >= (std::int64_t{1} << 40))
+                break;
+            iterations *= 2;
+        }
+
+        std::vector<double> nsPerOp;
+        nsPerOp.reserve(static_cast<std::size_t>(mRepetitions));
+        for (int r = 0; r < mRepetitions; r++)
+        {
+            auto start = Clock::now();
+            for (std::int64_t i = 0; i < iterations; i++)
+                op(i);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            nsPerOp.push_back(ns / static_cast<double>(iterations));
+        }
+
+        return store(group, name, variant, iterations, nsPerOp);
+    }
+
+    template <typename Op>
+    Result *Runner::runOnce(const QString &group, const QString &name, Op &&op, const QString &variant)
+    {
+        if (!enabled(group, name))
+            return nullptr;
+
+        std::vector<double> nsPerOp;
+        nsPerOp.reserve(static_cast<std::size_t>(mRepetitions));
+        for (int r = 0; r < mRepetitions; r++)
+        {
+            auto start = Clock::now();
+            op(r);
+            nsPerOp.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        }
+
+        return store(group, name, variant, 1, nsPerOp);
+    }
+
+    //Largest distance in units in the last place between two float arrays.
+    //For approximations - -0 and +0 are the same here, and so are all NaNs.
+    double maxUlpDifference(const float *a, const float *b, std::size_t count);
+
+    //Index of the first element whose bits differ (ex. -0 and +0), or count if all are the same
+    std::size_t firstBitDifference(const float *a, const float *b, std::size_t count);
+
+    //For results that should be bit exact: 0 if they are, else maxUlpDifference() but at least 1
+    double bitExactError(const float *a, const float *b, std::size_t count);
+
+} //namespace bench
+
+#endif // BENCHMARK_H
@@ -0,0 +1,9 @@
+# Timing and JSON/CSV output shared by the benchmark targets
+
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/benchmark.h
+
+SOURCES += \
+    $$PWD/benchmark.cpp
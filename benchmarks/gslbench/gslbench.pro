@@ -0,0 +1,18 @@
+# Headless microbenchmarks for the GSL math library.
+# Build in release mode, then run ex. "gslbench --format csv -o results.csv"
+
+QT          += core gui
+
+TEMPLATE    = app
+CONFIG      += c++17 console
+CONFIG      -= app_bundle
+
+TARGET      = gslbench
+
+include(../../GSL/gsl.pri)
+include(../common/common.pri)
+
+#gltypes.h lives in the engine folder
+INCLUDEPATH += ../..
+
+SOURCES += main.cpp
@@ -0,0 +1,580 @@
+//Microbenchmarks for the GSL math library.
+//Runs headless - no window or OpenGL context - and writes the results as JSON or CSV,
+//so runs on different machines and builds can be compared.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "vector2d.h"
+#include "vector3d.h"
+#include "vector4d.h"
+#include "matrix2x2.h"
+#include "matrix3x3.h"
+#include "matrix4x4.h"
+#include "quaternion.h"
+#include "gsl_math.h"
+#include "gsl_simd.h"
+#include "fastmath.h"
+#include "batchtransform.h"
+#include "beziercurve.h"
+#include "bsplinecurve.h"
+
+using bench::doNotOptimize;
+using bench::Runner;
+
+namespace
+{
+    //Inputs are picked from small tables of random values with index & Mask,
+    //so the compiler can't fold them into constants
+    constexpr std::size_t InputCount = 64;
+    constexpr std::size_t Mask = InputCount - 1;
+
+    std::mt19937 randomEngine{2019};
+
+    GLfloat randomFloat(GLfloat min = -10.f, GLfloat max = 10.f)
+    {
+        return std::uniform_real_distribution<GLfloat>{min, max}(randomEngine);
+    }
+
+    gsl::Vector3D randomVector()
+    {
+        return {randomFloat(), randomFloat(), randomFloat()};
+    }
+
+    //Rotation, scale and translation - like a model matrix
+    gsl::Matrix4x4 randomAffineMatrix()
+    {
+        gsl::Matrix4x4 matrix(true);
+        matrix.translate(randomVector());
+        matrix.rotateX(randomFloat(-180.f, 180.f));
+        matrix.rotateY(randomFloat(-180.f, 180.f));
+        matrix.scale(gsl::Vector3D(randomFloat(0.5f, 2.f), randomFloat(0.5f, 2.f), randomFloat(0.5f, 2.f)));
+        return matrix;
+    }
+
+    gsl::Matrix4x4 randomMatrix()
+    {
+        gsl::Matrix4x4 matrix;
+        for (int i = 0; i < 16; i++)
+            matrix.constData()[i] = randomFloat();
+        return matrix;
+    }
+
+    //Matrix4x4::operator* as it was before the SIMD kernels, copied verbatim,
+    //so the kernels are checked against the original code and not only against each other
+    struct BaselineMatrix4x4
+    {
+        GLfloat matrix[16];
+
+        explicit BaselineMatrix4x4(const gsl::Matrix4x4 &m)
+        {
+            std::memcpy(matrix, m.constData(), sizeof(matrix));
+        }
+
+        gsl::Matrix4x4 operator*(const BaselineMatrix4x4 &other)
+        {
+            return
+            {
+                matrix[0]  * other.matrix[0] + matrix[1]  * other.matrix[4] + matrix[2]  * other.matrix[8]  + matrix[3]  * other.matrix[12],
+                        matrix[0]  * other.matrix[1] + matrix[1]  * other.matrix[5] + matrix[2]  * other.matrix[9]  + matrix[3]  * other.matrix[13],
+                        matrix[0]  * other.matrix[2] + matrix[1]  * other.matrix[6] + matrix[2]  * other.matrix[10] + matrix[3]  * other.matrix[14],
+                        matrix[0]  * other.matrix[3] + matrix[1]  * other.matrix[7] + matrix[2]  * other.matrix[11] + matrix[3]  * other.matrix[15],
+
+                        matrix[4]  * other.matrix[0] + matrix[5]  * other.matrix[4] + matrix[6]  * other.matrix[8]  + matrix[7]  * other.matrix[12],
+                        matrix[4]  * other.matrix[1] + matrix[5]  * other.matrix[5] + matrix[6]  * other.matrix[9]  + matrix[7]  * other.matrix[13],
+                        matrix[4]  * other.matrix[2] + matrix[5]  * other.matrix[6] + matrix[6]  * other.matrix[10] + matrix[7]  * other.matrix[14],
+                        matrix[4]  * other.matrix[3] + matrix[5]  * other.matrix[7] + matrix[6]  * other.matrix[11] + matrix[7]  * other.matrix[15],
+
+                        matrix[8]  * other.matrix[0] + matrix[9]  * other.matrix[4] + matrix[10] * other.matrix[8]  + matrix[11] * other.matrix[12],
+                        matrix[8]  * other.matrix[1] + matrix[9]  * other.matrix[5] + matrix[10] * other.matrix[9]  + matrix[11] * other.matrix[13],
+                        matrix[8]  * other.matrix[2] + matrix[9]  * other.matrix[6] + matrix[10] * other.matrix[10] + matrix[11] * other.matrix[14],
+                        matrix[8]  * other.matrix[3] + matrix[9]  * other.matrix[7] + matrix[10] * other.matrix[11] + matrix[11] * other.matrix[15],
+
+                        matrix[12] * other.matrix[0] + matrix[13] * other.matrix[4] + matrix[14] * other.matrix[8]  + matrix[15] * other.matrix[12],
+                        matrix[12] * other.matrix[1] + matrix[13] * other.matrix[5] + matrix[14] * other.matrix[9]  + matrix[15] * other.matrix[13],
+                        matrix[12] * other.matrix[2] + matrix[13] * other.matrix[6] + matrix[14] * other.matrix[10] + matrix[15] * other.matrix[14],
+                        matrix[12] * other.matrix[3] + matrix[13] * other.matrix[7] + matrix[14] * other.matrix[11] + matrix[15] * other.matrix[15]
+            };
+        }
+
+        gsl::Vector4D operator*(const gsl::Vector4D &v)
+        {
+            return gsl::Vector4D(matrix[0]*v.getX()  + matrix[1]*v.getY()  + matrix[2]*v.getZ()  + matrix[3] *v.getW(),
+                    matrix[4]*v.getX()  + matrix[5]*v.getY()  + matrix[6]*v.getZ()  + matrix[7] *v.getW(),
+                    matrix[8]*v.getX()  + matrix[9]*v.getY()  + matrix[10]*v.getZ() + matrix[11] *v.getW(),
+                    matrix[12]*v.getX() + matrix[13]*v.getY() + matrix[14]*v.getZ() + matrix[15] *v.getW());
+        }
+    };
+
+    //Values where a changed order of operations, flush-to-zero or a lost sign would show
+    const GLfloat EdgeValues[] = {0.f, -0.f, 1.f, -1.f, FLT_MIN, -FLT_MIN, FLT_TRUE_MIN, -FLT_TRUE_MIN, 1.0e-40f, -3.0e-39f,
+                                  1.0e19f, -1.0e19f, 3.0e37f, FLT_MAX, -FLT_MAX};
+
+    //Half edge values, half random ones with large and small magnitudes
+    GLfloat randomCheckValue()
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, 2 * std::size(EdgeValues) - 1);
+        std::size_t index = pick(randomEngine);
+        if (index < std::size(EdgeValues))
+            return EdgeValues[index];
+        return randomFloat() * std::pow(10.f, randomFloat(-30.f, 30.f));
+    }
+
+    //Writes the first result whose bits differ from the baseline to stderr
+    bool reportFirstBitDifference(const QString &what, const GLfloat *results, const GLfloat *reference, std::size_t count)
+    {
+        std::size_t index = bench::firstBitDifference(results, reference, count);
+        if (index == count)
+            return true;
+
+        std::uint32_t resultBits, referenceBits;
+        std::memcpy(&resultBits, &results[index], sizeof(resultBits));
+        std::memcpy(&referenceBits, &reference[index], sizeof(referenceBits));
+        QTextStream(stderr) << what << " differs from the baseline at float " << index << ": "
+                            << results[index] << " (0x" << QString::number(resultBits, 16) << ") instead of "
+                            << reference[index] << " (0x" << QString::number(referenceBits, 16) << ")\n";
+        return false;
+    }
+
+    /**
+     * Checks that the Matrix4x4 multiply kernels of every instruction set the CPU has
+     * give bit for bit the same result as the baseline code.
+     * Runs even if the filter skips the benchmarks, so a run can be used as a test.
+     * @return false, with the first difference on stderr, if any result has other bits - -0 instead of 0 counts
+     */
+    bool checkMatrix4x4Kernels()
+    {
+        using gsl::simd::InstructionSet;
+
+        constexpr std::size_t CheckCount = 4096;
+        std::vector<gsl::Matrix4x4> lhs(CheckCount), rhs(CheckCount);
+        std::vector<gsl::Vector4D> vectors(CheckCount);
+        for (std::size_t i = 0; i < CheckCount; i++)
+        {
+            //The first ones are plain random matrices, the rest mix in edge values
+            for (int j = 0; j < 16; j++)
+            {
+                lhs[i].constData()[j] = i < 256 ? randomFloat() : randomCheckValue();
+                rhs[i].constData()[j] = i < 256 ? randomFloat() : randomCheckValue();
+            }
+            vectors[i] = gsl::Vector4D(randomCheckValue(), randomCheckValue(), randomCheckValue(), randomCheckValue());
+        }
+        //Then every edge value times every other one
+        for (std::size_t i = 0; i < std::size(EdgeValues); i++)
+        {
+            for (std::size_t j = 0; j < std::size(EdgeValues); j++)
+            {
+                std::size_t index = 256 + i * std::size(EdgeValues) + j;
+                for (int k = 0; k < 16; k++)
+                {
+                    lhs[index].constData()[k] = EdgeValues[i];
+                    rhs[index].constData()[k] = EdgeValues[(j + k) % std::size(EdgeValues)];
+                }
+                vectors[index] = gsl::Vector4D(EdgeValues[j], EdgeValues[i], -EdgeValues[j], EdgeValues[(i + j) % std::size(EdgeValues)]);
+            }
+        }
+
+        std::vector<gsl::Matrix4x4> referenceMatrices(CheckCount);
+        std::vector<gsl::Vector4D> referenceVectors(CheckCount);
+        for (std::size_t i = 0; i < CheckCount; i++)
+        {
+            BaselineMatrix4x4 baseline(lhs[i]);
+            referenceMatrices[i] = baseline * BaselineMatrix4x4(rhs[i]);
+            referenceVectors[i] = baseline * vectors[i];
+        }
+
+        InstructionSet original = gsl::simd::activeInstructionSet();
+        InstructionSet supported = gsl::simd::supportedInstructionSet();
+        bool exact = true;
+        for (InstructionSet set : {InstructionSet::Scalar, InstructionSet::SSE, InstructionSet::AVX})
+        {
+            if (static_cast<int>(set) > static_cast<int>(supported))
+                break;
+
+            gsl::simd::setInstructionSet(set);
+            std::vector<gsl::Matrix4x4> matrices(CheckCount);
+            std::vector<gsl::Vector4D> results(CheckCount);
+            for (std::size_t i = 0; i < CheckCount; i++)
+            {
+                matrices[i] = lhs[i] * rhs[i];
+                results[i] = lhs[i] * vectors[i];
+            }
+
+            QString name = gsl::simd::instructionSetName(set);
+            exact &= reportFirstBitDifference(name + " Matrix4x4*Matrix4x4", matrices[0].constData(),
+                                              referenceMatrices[0].constData(), 16 * CheckCount);
+            exact &= reportFirstBitDifference(name + " Matrix4x4*Vector4D", &results[0].x,
+                                              &referenceVectors[0].x, 4 * CheckCount);
+        }
+
+        gsl::simd::setInstructionSet(original);
+        return exact;
+    }
+
+    void benchVectors(Runner &runner)
+    {
+        std::array<gsl::Vector3D, InputCount> a, b;
+        std::array<GLfloat, InputCount> scalars;
+        for (std::size_t i = 0; i < InputCount; i++)
+        {
+            a[i] = randomVector();
+            b[i] = randomVector();
+            scalars[i] = randomFloat();
+        }
+
+        runner.run("Vector3D", "add", [&](std::int64_t i) { doNotOptimize(a[i & Mask] + b[i & Mask]); });
+        runner.run("Vector3D", "multiplyScalar", [&](std::int64_t i) { doNotOptimize(a[i & Mask] * scalars[i & Mask]); });
+        runner.run("Vector3D", "dot", [&](std::int64_t i) { doNotOptimize(gsl::Vector3D::dot(a[i & Mask], b[i & Mask])); });
+        runner.run("Vector3D", "cross", [&](std::int64_t i) { doNotOptimize(a[i & Mask] ^ b[i & Mask]); });
+        runner.run("Vector3D", "length", [&](std::int64_t i) { doNotOptimize(a[i & Mask].length()); });
+        runner.run("Vector3D", "normalized", [&](std::int64_t i) { doNotOptimize(a[i & Mask].normalized()); });
+        runner.run("Vector3D", "rotateY", [&](std::int64_t i) {
+            gsl::Vector3D v = a[i & Mask];
+            v.rotateY(scalars[i & Mask]);
+            doNotOptimize(v);
+        });
+
+        std::array<gsl::Quaternion, InputCount> q;
+        for (std::size_t i = 0; i < InputCount; i++)
+            q[i] = gsl::Quaternion::fromAxisAngle(b[i].normalized(), randomFloat(-180.f, 180.f));
+
+        runner.run("Quaternion", "multiply", [&](std::int64_t i) { doNotOptimize(q[i & Mask] * q[(i + 1) & Mask]); });
+        runner.run("Quaternion", "rotateVector", [&](std::int64_t i) { doNotOptimize(q[i & Mask].rotate(a[i & Mask])); });
+        runner.run("Quaternion", "toMatrix4", [&](std::int64_t i) { doNotOptimize(q[i & Mask].toMatrix4()); });
+        runner.run("Quaternion", "slerp", [&](std::int64_t i) {
+            doNotOptimize(gsl::Quaternion::slerp(q[i & Mask], q[(i + 1) & Mask], 0.3f));
+        });
+    }
+
+    void benchMatrices(Runner &runner)
+    {
+        std::array<gsl::Matrix2x2, InputCount> m2;
+        std::array<gsl::Matrix3x3, InputCount> m3;
+        std::array<gsl::Matrix4x4, InputCount> m4, affine;
+        std::array<gsl::Vector2D, InputCount> v2;
+        std::array<gsl::Vector3D, InputCount> v3;
+        std::array<gsl::Vector4D, InputCount> v4;
+        for (std::size_t i = 0; i < InputCount; i++)
+        {
+            m2[i] = gsl::Matrix2x2{randomFloat(), randomFloat(), randomFloat(), randomFloat()};
+            m3[i] = gsl::Matrix3x3{randomFloat(), randomFloat(), randomFloat(),
+                                   randomFloat(), randomFloat(), randomFloat(),
+                                   randomFloat(), randomFloat(), randomFloat()};
+            m4[i] = randomMatrix();
+            affine[i] = randomAffineMatrix();
+            v2[i] = gsl::Vector2D(randomFloat(), randomFloat());
+            v3[i] = randomVector();
+            v4[i] = gsl::Vector4D(randomFloat(), randomFloat(), randomFloat(), randomFloat());
+        }
+
+        runner.run("Matrix2x2", "multiplyMatrix", [&](std::int64_t i) { doNotOptimize(m2[i & Mask] * m2[(i + 1) & Mask]); });
+        runner.run("Matrix2x2", "multiplyVector", [&](std::int64_t i) { doNotOptimize(m2[i & Mask] * v2[i & Mask]); });
+        runner.run("Matrix2x2", "inverse", [&](std::int64_t i) {
+            gsl::Matrix2x2 m = m2[i & Mask];
+            doNotOptimize(m.inverse());
+            doNotOptimize(m);
+        });
+
+        runner.run("Matrix3x3", "multiplyMatrix", [&](std::int64_t i) { doNotOptimize(m3[i & Mask] * m3[(i + 1) & Mask]); });
+        runner.run("Matrix3x3", "multiplyVector", [&](std::int64_t i) { doNotOptimize(m3[i & Mask] * v3[i & Mask]); });
+        runner.run("Matrix3x3", "inverse", [&](std::int64_t i) {
+            gsl::Matrix3x3 m = m3[i & Mask];
+            doNotOptimize(m.inverse());
+            doNotOptimize(m);
+        });
+
+        runner.run("Matrix4x4", "multiplyMatrix", [&](std::int64_t i) { doNotOptimize(m4[i & Mask] * m4[(i + 1) & Mask]); });
+        runner.run("Matrix4x4", "multiplyVector", [&](std::int64_t i) { doNotOptimize(m4[i & Mask] * v4[i & Mask]); });
+        runner.run("Matrix4x4", "inverseGeneral", [&](std::int64_t i) {
+            gsl::Matrix4x4 m = m4[i & Mask];
+            doNotOptimize(m.inverse());
+            doNotOptimize(m);
+        });
+        runner.run("Matrix4x4", "inverseAffine", [&](std::int64_t i) {
+            gsl::Matrix4x4 m = affine[i & Mask];
+            doNotOptimize(m.inverseAffine());
+            doNotOptimize(m);
+        });
+        runner.run("Matrix4x4", "inverseRigid", [&](std::int64_t i) {
+            gsl::Matrix4x4 m = affine[i & Mask];
+            m.inverseRigid();
+            doNotOptimize(m);
+        });
+        runner.run("Matrix4x4", "translateRotateScale", [&](std::int64_t i) {
+            gsl::Matrix4x4 m = affine[i & Mask];
+            m.translate(v3[i & Mask]);
+            m.rotateY(v4[i & Mask].x);
+            m.scale(v3[(i + 1) & Mask]);
+            doNotOptimize(m);
+        });
+        runner.run("Matrix4x4", "perspective", [&](std::int64_t i) {
+            gsl::Matrix4x4 m;
+            m.perspective(45.f + v4[i & Mask].x, 16.f / 9.f, 0.1f, 1000.f);
+            doNotOptimize(m);
+        });
+        runner.run("Matrix4x4", "lookAt", [&](std::int64_t i) {
+            gsl::Matrix4x4 m;
+            m.lookAt(v3[i & Mask], v3[(i + 1) & Mask], gsl::up());
+            doNotOptimize(m);
+        });
+    }
+
+    void benchTrig(Runner &runner)
+    {
+        std::array<GLfloat, InputCount> angles;
+        for (auto &angle : angles)
+            angle = randomFloat(-gsl::PI, gsl::PI);
+
+        std::array<GLfloat, 2 * InputCount> reference, fast;
+        for (std::size_t i = 0; i < InputCount; i++)
+        {
+            reference[i * 2] = std::sin(angles[i]);
+            reference[i * 2 + 1] = std::cos(angles[i]);
+            gsl::fast::sincos(angles[i], fast[i * 2], fast[i * 2 + 1]);
+        }
+
+        runner.run("Trig", "std::sin+std::cos", [&](std::int64_t i) {
+            doNotOptimize(std::sin(angles[i & Mask]));
+            doNotOptimize(std::cos(angles[i & Mask]));
+        });
+        if (auto *result = runner.run("Trig", "fast::sincos", [&](std::int64_t i) {
+                GLfloat s, c;
+                gsl::fast::sincos(angles[i & Mask], s, c);
+                doNotOptimize(s);
+                doNotOptimize(c);
+            }))
+        {
+            result->maxUlpError = bench::maxUlpDifference(fast.data(), reference.data(), fast.size());
+        }
+        runner.run("Trig", "fast::sincosDegrees", [&](std::int64_t i) {
+            GLfloat s, c;
+            gsl::fast::sincosDegrees(angles[i & Mask] * 57.f, s, c);
+            doNotOptimize(s);
+            doNotOptimize(c);
+        });
+        runner.run("Trig", "Matrix4x4::rotateY", [&](std::int64_t i) {
+            gsl::Matrix4x4 m(true);
+            m.rotateY(angles[i & Mask]);
+            doNotOptimize(m);
+        });
+    }
+
+    void benchCurves(Runner &runner)
+    {
+        std::vector<gsl::Vector3D> bezierPoints{randomVector(), randomVector(), randomVector(), randomVector()};
+        std::array<GLfloat, InputCount> t;
+        for (std::size_t i = 0; i < InputCount; i++)
+            t[i] = randomFloat(0.f, 1.f);
+
+        runner.run("Curves", "bezierCurve", [&](std::int64_t i) {
+            doNotOptimize(gsl::bezierCurve(bezierPoints, t[i & Mask]));
+        });
+
+        gsl::BezierCurve bezier(bezierPoints);
+        runner.run("Curves", "BezierCurve::evaluate", [&](std::int64_t i) { doNotOptimize(bezier.evaluate(t[i & Mask])); });
+
+        //A whole route per call
+        constexpr std::size_t SampleCount = 1024;
+        std::vector<gsl::Vector3D> samples(SampleCount);
+        runner.run("Curves", "BezierCurve::sampleUniform1024", [&](std::int64_t) {
+            bezier.sampleUniform(samples.data(), samples.size());
+            doNotOptimize(samples.back());
+        });
+
+        std::vector<gsl::Vector3D> splinePoints;
+        for (int i = 0; i < 16; i++)
+            splinePoints.push_back(randomVector());
+        gsl::BSplineCurve spline(splinePoints);
+        std::vector<GLfloat> knots = spline.knots();
+
+        runner.run("Curves", "bSpline", [&](std::int64_t i) {
+            doNotOptimize(gsl::bSpline(splinePoints, knots, t[i & Mask]));
+        });
+        runner.run("Curves", "BSplineCurve::evaluate", [&](std::int64_t i) { doNotOptimize(spline.evaluate(t[i & Mask])); });
+        runner.run("Curves", "BSplineCurve::sampleUniform1024", [&](std::int64_t) {
+            spline.sampleUniform(samples.data(), samples.size());
+            doNotOptimize(samples.back());
+        });
+    }
+
+    //Times the kernels on every instruction set the CPU has, and checks them against the scalar path.
+    //The matrix multiplies are checked against the baseline code instead.
+    //All but sincos must be bit exact, so any difference is reported as at least 1 ULP.
+    void benchSimd(Runner &runner)
+    {
+        using gsl::simd::InstructionSet;
+
+        constexpr std::size_t PointCount = 4096;
+        std::vector<gsl::Matrix4x4> lhs(InputCount), rhs(InputCount);
+        std::vector<gsl::Vector4D> vectors(InputCount);
+        std::vector<gsl::Vector3D> points(PointCount);
+        std::vector<GLfloat> angles(PointCount);
+        for (auto &angle : angles)
+            angle = randomFloat(-100.f, 100.f);
+        for (std::size_t i = 0; i < InputCount; i++)
+        {
+            lhs[i] = randomMatrix();
+            rhs[i] = randomMatrix();
+            vectors[i] = gsl::Vector4D(randomFloat(), randomFloat(), randomFloat(), randomFloat());
+        }
+        for (auto &point : points)
+            point = randomVector();
+        gsl::Matrix4x4 model = randomAffineMatrix();
+
+        //ARGB pixels to RGBA, like Texture does for bitmaps with an unusual channel order
+        const unsigned char order[4] = {1, 2, 3, 0};
+        std::vector<unsigned char> pixels(PointCount * 4);
+        for (auto &byte : pixels)
+            byte = static_cast<unsigned char>(randomEngine());
+        std::vector<unsigned char> referencePixels(pixels.size());
+        gsl::simd::shuffleBytes4Scalar(pixels.data(), referencePixels.data(), PointCount, order);
+
+        auto runAll = [&](std::vector<gsl::Matrix4x4> &matrixOut, std::vector<gsl::Vector4D> &vectorOut,
+                          std::vector<gsl::Vector3D> &pointOut, std::vector<GLfloat> &sineOut, std::vector<GLfloat> &cosineOut)
+        {
+            for (std::size_t i = 0; i < InputCount; i++)
+            {
+                matrixOut[i] = lhs[i] * rhs[i];
+                vectorOut[i] = lhs[i] * vectors[i];
+            }
+            gsl::transformPoints(model, points.data(), pointOut.data(), PointCount);
+            gsl::fast::sincos(angles.data(), sineOut.data(), cosineOut.data(), PointCount);
+        };
+
+        InstructionSet original = gsl::simd::activeInstructionSet();
+        InstructionSet supported = gsl::simd::supportedInstructionSet();
+
+        gsl::simd::setInstructionSet(InstructionSet::Scalar);
+        std::vector<gsl::Matrix4x4> referenceMatrices(InputCount);
+        std::vector<gsl::Vector4D> referenceVectors(InputCount);
+        std::vector<gsl::Vector3D> referencePoints(PointCount);
+        std::vector<GLfloat> referenceSines(PointCount), referenceCosines(PointCount);
+        runAll(referenceMatrices, referenceVectors, referencePoints, referenceSines, referenceCosines);
+        for (std::size_t i = 0; i < InputCount; i++)
+        {
+            BaselineMatrix4x4 baseline(lhs[i]);
+            referenceMatrices[i] = baseline * BaselineMatrix4x4(rhs[i]);
+            referenceVectors[i] = baseline * vectors[i];
+        }
+
+        for (InstructionSet set : {InstructionSet::Scalar, InstructionSet::SSE, InstructionSet::AVX})
+        {
+            if (static_cast<int>(set) > static_cast<int>(supported))
+                break;
+
+            gsl::simd::setInstructionSet(set);
+            QString variant = gsl::simd::instructionSetName(set);
+
+            std::vector<gsl::Matrix4x4> matrices(InputCount);
+            std::vector<gsl::Vector4D> results(InputCount);
+            std::vector<gsl::Vector3D> transformed(PointCount);
+            std::vector<GLfloat> sines(PointCount), cosines(PointCount);
+            runAll(matrices, results, transformed, sines, cosines);
+
+            if (auto *result = runner.run("Simd", "Matrix4x4*Matrix4x4",
+                                          [&](std::int64_t i) { doNotOptimize(lhs[i & Mask] * rhs[i & Mask]); }, variant))
+            {
+                result->maxUlpError = bench::bitExactError(matrices[0].constData(), referenceMatrices[0].constData(),
+                                                           16 * InputCount);
+            }
+            if (auto *result = runner.run("Simd", "Matrix4x4*Vector4D",
+                                          [&](std::int64_t i) { doNotOptimize(lhs[i & Mask] * vectors[i & Mask]); }, variant))
+            {
+                result->maxUlpError = bench::bitExactError(&results[0].x, &referenceVectors[0].x, 4 * InputCount);
+            }
+            if (auto *result = runner.run("Simd", "transformPoints4096", [&](std::int64_t) {
+                    gsl::transformPoints(model, points.data(), transformed.data(), PointCount);
+                    doNotOptimize(transformed.back());
+                }, variant))
+            {
+                result->maxUlpError = bench::bitExactError(&transformed[0].x, &referencePoints[0].x, 3 * PointCount);
+            }
+            if (auto *result = runner.run("Simd", "sincos4096", [&](std::int64_t) {
+                    gsl::fast::sincos(angles.data(), sines.data(), cosines.data(), PointCount);
+                    doNotOptimize(sines.back());
+                }, variant))
+            {
+                result->maxUlpError = std::max(bench::maxUlpDifference(sines.data(), referenceSines.data(), PointCount),
+                                               bench::maxUlpDifference(cosines.data(), referenceCosines.data(), PointCount));
+            }
+
+            std::vector<unsigned char> shuffled(pixels.size());
+            if (auto *result = runner.run("Simd", "shuffleBytes4096", [&](std::int64_t) {
+                    gsl::simd::shuffleBytes4(pixels.data(), shuffled.data(), PointCount, order);
+                    doNotOptimize(shuffled.back());
+                }, variant))
+            {
+                //Bytes are exact or wrong
+                result->maxUlpError = shuffled == referencePixels ? 0.0 : 1.0;
+            }
+        }
+
+        gsl::simd::setInstructionSet(original);
+    }
+} //namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("gslbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Microbenchmarks for the GSL math library");
+    parser.addHelpOption();
+    QCommandLineOption formatOption("format", "Output format: json or csv.", "format", "json");
+    QCommandLineOption outputOption({"o", "output"}, "Write the results to <file> instead of stdout.", "file");
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose group/name contains <text>.", "text");
+    QCommandLineOption repetitionsOption("repetitions", "Timed batches per benchmark.", "count", "9");
+    QCommandLineOption minTimeOption("min-time", "Shortest batch, in milliseconds.", "ms", "20");
+    parser.addOptions({formatOption, outputOption, filterOption, repetitionsOption, minTimeOption});
+    parser.process(app);
+
+    Runner runner(parser.value(filterOption), parser.value(repetitionsOption).toInt(),
+                  parser.value(minTimeOption).toDouble());
+
+    runner.addInfo("supportedInstructionSet", gsl::simd::instructionSetName(gsl::simd::supportedInstructionSet()));
+#ifdef QT_DEBUG
+    runner.addInfo("build", "debug");
+#else
+    runner.addInfo("build", "release");
+#endif
+
+    //Checked before anything is timed, and turned into the exit code
+    bool kernelsExact = checkMatrix4x4Kernels();
+
+    benchVectors(runner);
+    benchMatrices(runner);
+    benchTrig(runner);
+    benchCurves(runner);
+    benchSimd(runner);
+
+    QString format = parser.value(formatOption).toLower();
+    QString text = format == "csv" ? runner.toCsv() : runner.toJson();
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QTextStream(stderr) << "Could not open " << file.fileName() << " for writing\n";
+            return 1;
+        }
+        QTextStream(&file) << text;
+    }
+    else
+    {
+        QTextStream(stdout) << text;
+    }
+
+    return kernelsExact ? 0 : 1;
+}
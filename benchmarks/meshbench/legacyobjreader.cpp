@@ -0,0 +1,114 @@
+#include "legacyobjreader.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//Body of the old ObjMesh::readFile, with the output going to a MeshData
+bool readObjLegacy(const std::string &filePath, MeshData &mesh)
+{
+    mesh.clear();
+
+    std::ifstream fileIn;
+    fileIn.open (filePath, std::ifstream::in);
+    if(!fileIn)
+        return false;
+
+    std::string oneLine;
+    std::string oneWord;
+
+    std::vector<gsl::Vector3D> tempVertecies;
+    std::vector<gsl::Vector3D> tempNormals;
+    std::vector<gsl::Vector2D> tempUVs;
+
+    unsigned int temp_index = 0;
+
+    while(std::getline(fileIn, oneLine))
+    {
+        std::stringstream sStream;
+        sStream << oneLine;
+        oneWord = "";
+        sStream >> oneWord;
+
+        if (oneWord == "#")
+            continue;
+        if (oneWord == "")
+            continue;
+        if (oneWord == "v")
+        {
+            gsl::Vector3D tempVertex;
+            sStream >> oneWord;
+            tempVertex.x = std::stof(oneWord);
+            sStream >> oneWord;
+            tempVertex.y = std::stof(oneWord);
+            sStream >> oneWord;
+            tempVertex.z = std::stof(oneWord);
+            tempVertecies.push_back(tempVertex);
+            continue;
+        }
+        if (oneWord == "vt")
+        {
+            gsl::Vector2D tempUV;
+            sStream >> oneWord;
+            tempUV.x = std::stof(oneWord);
+            sStream >> oneWord;
+            tempUV.y = std::stof(oneWord);
+            tempUVs.push_back(tempUV);
+            continue;
+        }
+        if (oneWord == "vn")
+        {
+            gsl::Vector3D tempNormal;
+            sStream >> oneWord;
+            tempNormal.x = std::stof(oneWord);
+            sStream >> oneWord;
+            tempNormal.y = std::stof(oneWord);
+            sStream >> oneWord;
+            tempNormal.z = std::stof(oneWord);
+            tempNormals.push_back(tempNormal);
+            continue;
+        }
+        if (oneWord == "f")
+        {
+            int index, normal, uv;
+            for(int i = 0; i < 3; i++)
+            {
+                sStream >> oneWord;
+                std::stringstream tempWord(oneWord);
+                std::string segment;
+                std::vector<std::string> segmentArray;
+                while(std::getline(tempWord, segment, '/'))
+                {
+                    segmentArray.push_back(segment);
+                }
+                index = std::stoi(segmentArray[0]);
+                if (segmentArray[1] != "")
+                    uv = std::stoi(segmentArray[1]);
+                else
+                {
+                    uv = 0;
+                }
+                normal = std::stoi(segmentArray[2]);
+
+                --index;
+                --uv;
+                --normal;
+
+                if (uv > -1)
+                {
+                    Vertex tempVert(tempVertecies[index], tempNormals[normal], tempUVs[uv]);
+                    mesh.vertices.push_back(tempVert);
+                }
+                else
+                {
+                    Vertex tempVert(tempVertecies[index], tempNormals[normal], gsl::Vector2D(0.0f, 0.0f));
+                    mesh.vertices.push_back(tempVert);
+                }
+                mesh.indices.push_back(temp_index++);
+            }
+            continue;
+        }
+    }
+
+    fileIn.close();
+    return true;
+}
@@ -0,0 +1,11 @@
+#ifndef LEGACYOBJREADER_H
+#define LEGACYOBJREADER_H
+
+#include <string>
+#include "meshdata.h"
+
+//The stringstream based obj reader that ObjMesh::readFile used before ObjReader.
+//Kept unchanged here as the baseline for the parser benchmarks.
+bool readObjLegacy(const std::string &filePath, MeshData &mesh);
+
+#endif // LEGACYOBJREADER_H
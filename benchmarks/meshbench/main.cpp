@@ -0,0 +1,346 @@
+//Benchmarks for loading meshes.
+//Runs headless and writes the results as JSON or CSV, like gslbench.
+//The obj files are generated grids unless files are given with --obj-file.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "benchmark.h"
+#include "legacyobjreader.h"
+#include "meshfile.h"
+#include "meshoptimizer.h"
+#include "meshsimplifier.h"
+#include "objreader.h"
+
+using bench::doNotOptimize;
+using bench::Runner;
+
+namespace
+{
+    //Writes a gridSize x gridSize grid of quads as triangles with v/vt/vn corners,
+    //with a bumpy surface so the numbers have the usual number of digits
+    bool writeGridObj(const QString &filePath, int gridSize)
+    {
+        std::ofstream out(filePath.toStdString(), std::ios::binary);
+        if (!out)
+            return false;
+
+        char line[256];
+        out << "# " << gridSize << " x " << gridSize << " grid made by meshbench\n";
+        for (int z = 0; z <= gridSize; z++)
+        {
+            for (int x = 0; x <= gridSize; x++)
+            {
+                double height = std::sin(x * 0.37) * std::cos(z * 0.23) * 2.5;
+                int length = std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n",
+                                           x * 0.1 - gridSize * 0.05, height, z * 0.1 - gridSize * 0.05);
+                out.write(line, length);
+            }
+        }
+        for (int z = 0; z <= gridSize; z++)
+        {
+            for (int x = 0; x <= gridSize; x++)
+            {
+                int length = std::snprintf(line, sizeof(line), "vt %.6f %.6f\n",
+                                           static_cast<double>(x) / gridSize, static_cast<double>(z) / gridSize);
+                out.write(line, length);
+            }
+        }
+        for (int z = 0; z <= gridSize; z++)
+        {
+            for (int x = 0; x <= gridSize; x++)
+            {
+                double nx = -std::cos(x * 0.37) * std::cos(z * 0.23) * 0.925;
+                double nz = std::sin(x * 0.37) * std::sin(z * 0.23) * 0.575;
+                double length = std::sqrt(nx * nx + 1.0 + nz * nz);
+                int written = std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n",
+                                            nx / length, 1.0 / length, nz / length);
+                out.write(line, written);
+            }
+        }
+        out << "s off\n";
+        for (int z = 0; z < gridSize; z++)
+        {
+            for (int x = 0; x < gridSize; x++)
+            {
+                int a = z * (gridSize + 1) + x + 1;     //obj indices start at 1
+                int b = a + 1;
+                int c = a + gridSize + 1;
+                int d = c + 1;
+                int length = std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d\nf %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                           a, a, a, c, c, c, b, b, b, b, b, b, c, c, c, d, d, d);
+                out.write(line, length);
+            }
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool sameMesh(const MeshData &a, const MeshData &b)
+    {
+        return a.vertices.size() == b.vertices.size() && a.indices.size() == b.indices.size() &&
+                std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex)) == 0 &&
+                std::memcmp(a.indices.data(), b.indices.data(), a.indices.size() * sizeof(GLuint)) == 0;
+    }
+
+    //Same triangles with the same vertex data, however the vertices are shared
+    bool sameTriangles(const MeshData &a, const MeshData &b)
+    {
+        if (a.indices.size() != b.indices.size())
+            return false;
+        for (std::size_t i = 0; i < a.indices.size(); i++)
+        {
+            if (std::memcmp(&a.vertices[a.indices[i]], &b.vertices[b.indices[i]], sizeof(Vertex)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    //Same triangles in any order, each starting at any of its corners
+    bool sameTriangleSet(const MeshData &a, const MeshData &b)
+    {
+        using Triangle = std::array<Vertex, 3>;
+        auto triangles = [](const MeshData &mesh) {
+            auto less = [](const Vertex &x, const Vertex &y) { return std::memcmp(&x, &y, sizeof(Vertex)) < 0; };
+            std::vector<Triangle> result(mesh.indices.size() / 3);
+            for (std::size_t t = 0; t < result.size(); t++)
+            {
+                Triangle &triangle = result[t];
+                for (std::size_t corner = 0; corner < 3; corner++)
+                    triangle[corner] = mesh.vertices[mesh.indices[t * 3 + corner]];
+                //Rotate the smallest corner first, keeping the winding
+                std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end(), less), triangle.end());
+            }
+            std::sort(result.begin(), result.end(), [](const Triangle &x, const Triangle &y) {
+                return std::memcmp(x.data(), y.data(), sizeof(Triangle)) < 0;
+            });
+            return result;
+        };
+        std::vector<Triangle> first = triangles(a);
+        std::vector<Triangle> second = triangles(b);
+        return first.size() == second.size() &&
+                std::memcmp(first.data(), second.data(), first.size() * sizeof(Triangle)) == 0;
+    }
+
+    void benchObjFile(Runner &runner, const QString &filePath, const QString &cacheFolder, unsigned maxThreads)
+    {
+        QString name = QFileInfo(filePath).fileName();
+        std::string path = filePath.toStdString();
+        double bytes = static_cast<double>(QFileInfo(filePath).size());
+
+        //The new reader must give exactly the same triangles as the old one
+        MeshData legacyMesh;
+        MeshData mesh;
+        ObjReader::Statistics statistics;
+        bool legacyOk = readObjLegacy(path, legacyMesh);
+        bool ok = ObjReader::readFile(path, mesh, &statistics);
+        runner.addInfo(name + ".verticesBeforeWelding", QString::number(statistics.faceCorners));
+        runner.addInfo(name + ".vertices", QString::number(statistics.vertices));
+        runner.addInfo(name + ".matchesLegacy", legacyOk && ok && sameTriangles(legacyMesh, mesh) ? "yes" : "no");
+        legacyMesh = MeshData();
+
+        //Triangle order for the vertex cache, as the file had it and after MeshOptimizer
+        if (runner.enabled("optimize", name))
+        {
+            MeshData optimized = mesh;
+            MeshOptimizer::Statistics optimizeStatistics;
+            MeshOptimizer::optimize(optimized, &optimizeStatistics);
+            runner.addInfo(name + ".acmrBefore", QString::number(optimizeStatistics.acmrBefore));
+            runner.addInfo(name + ".acmrAfter", QString::number(optimizeStatistics.acmrAfter));
+            runner.addInfo(name + ".overdrawClusters", QString::number(optimizeStatistics.clusters));
+            runner.addInfo(name + ".optimizedMatchesSource", sameTriangleSet(mesh, optimized) ? "yes" : "no");
+
+            runner.runOnce("optimize", name, [&](int) {
+                MeshData data = mesh;
+                MeshOptimizer::optimize(data);
+                doNotOptimize(data);
+            }, "vertex cache + overdraw");
+            runner.runOnce("optimize", name, [&](int) {
+                MeshData data = mesh;
+                MeshOptimizer::optimize(data, nullptr, 0.f);
+                doNotOptimize(data);
+            }, "vertex cache");
+        }
+
+        //Levels of detail, as triangles and error per level
+        if (runner.enabled("lod", name))
+        {
+            MeshData withLods = mesh;
+            MeshSimplifier::generateLods(withLods);
+            QStringList levels;
+            for (const MeshLod &lod : withLods.lods)
+                levels.append(QString("%1 (%2)").arg(lod.indexCount / 3).arg(lod.error));
+            runner.addInfo(name + ".lods", levels.join(", "));
+
+            runner.runOnce("lod", name, [&](int) {
+                MeshData data = mesh;
+                MeshSimplifier::generateLods(data);
+                doNotOptimize(data);
+            }, "generateLods");
+        }
+
+        //Binary cache made from the mesh, like ObjMesh does after the first parse
+        std::string cachePath = QDir(cacheFolder).filePath(name + ".mesh").toStdString();
+        bool cacheOk = MeshFile::write(cachePath, path, mesh.vertices.data(), mesh.vertices.size(),
+                                       mesh.indices.data(), mesh.indices.size());
+        mesh = MeshData();
+
+        if (bench::Result *result = runner.runOnce("obj", name, [&](int) {
+            MeshData data;
+            readObjLegacy(path, data);
+            doNotOptimize(data);
+        }, "legacy"))
+            result->bytesPerOp = bytes;
+
+        if (bench::Result *result = runner.runOnce("obj", name, [&](int) {
+            MeshData data;
+            ObjReader::readFile(path, data);
+            doNotOptimize(data);
+        }, "ObjReader"))
+            result->bytesPerOp = bytes;
+
+        //Mapping the cache and copying the arrays out, like glBufferData does
+        if (cacheOk)
+        {
+            double cacheBytes = static_cast<double>(QFileInfo(QString::fromStdString(cachePath)).size());
+            if (bench::Result *result = runner.runOnce("obj", name, [&](int) {
+                MeshFile meshFile;
+                meshFile.open(cachePath, path);
+                std::vector<Vertex> vertices(meshFile.vertices(), meshFile.vertices() + meshFile.vertexCount());
+                std::vector<GLuint> indices(meshFile.indices(), meshFile.indices() + meshFile.indexCount());
+                doNotOptimize(vertices);
+                doNotOptimize(indices);
+            }, "MeshFile cache"))
+                result->bytesPerOp = cacheBytes;
+        }
+
+        //Parsing only, from text already in memory
+        QFile file(filePath);
+        if ((!runner.enabled("obj", name) && !runner.enabled("obj-threads", name)) || !file.open(QIODevice::ReadOnly))
+            return;
+        QByteArray text = file.readAll();
+        if (bench::Result *result = runner.runOnce("obj", name, [&](int) {
+            MeshData data;
+            ObjReader::parse(text.constData(), static_cast<std::size_t>(text.size()), data);
+            doNotOptimize(data);
+        }, "ObjReader parse only"))
+            result->bytesPerOp = bytes;
+
+        //Scaling with the number of threads, 1, 2, 4 ... maxThreads.
+        //Every thread count must give exactly the same mesh as one thread.
+        MeshData singleThreaded;
+        ObjReader::parse(text.constData(), static_cast<std::size_t>(text.size()), singleThreaded);
+        bool allSame = true;
+        for (unsigned threads = 1; ; threads = std::min(threads * 2, maxThreads))
+        {
+            MeshData threaded;
+            ObjReader::parse(text.constData(), static_cast<std::size_t>(text.size()), threaded, name.toStdString(),
+                             nullptr, threads);
+            allSame = allSame && sameMesh(singleThreaded, threaded);
+
+            if (bench::Result *result = runner.runOnce("obj-threads", name, [&](int) {
+                MeshData data;
+                ObjReader::parse(text.constData(), static_cast<std::size_t>(text.size()), data, name.toStdString(),
+                                 nullptr, threads);
+                doNotOptimize(data);
+            }, QString("%1 threads").arg(threads)))
+                result->bytesPerOp = bytes;
+
+            if (threads == maxThreads)
+                break;
+        }
+        runner.addInfo(name + ".threadedMatchesSingleThreaded", allSame ? "yes" : "no");
+    }
+
+} //namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("meshbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks for mesh loading");
+    parser.addHelpOption();
+    QCommandLineOption formatOption("format", "Output format: json or csv.", "format", "json");
+    QCommandLineOption outputOption({"o", "output"}, "Write the results to <file> instead of stdout.", "file");
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose group/name contains <text>.", "text");
+    QCommandLineOption repetitionsOption("repetitions", "Timed runs per benchmark.", "count", "5");
+    QCommandLineOption objFileOption("obj-file", "Obj file to load. Can be given more than once.", "file");
+    QCommandLineOption gridOption("grid", "Size of the generated grid meshes, comma separated.", "sizes", "128,512");
+    QCommandLineOption threadsOption("threads", "Most threads for the parsing scaling test, 0 for one per core.", "count", "0");
+    parser.addOptions({formatOption, outputOption, filterOption, repetitionsOption, objFileOption, gridOption,
+                       threadsOption});
+    parser.process(app);
+
+    //Each run is a whole file, so there is no minimum batch time
+    Runner runner(parser.value(filterOption), parser.value(repetitionsOption).toInt(), 0.0);
+#ifdef QT_DEBUG
+    runner.addInfo("build", "debug");
+#else
+    runner.addInfo("build", "release");
+#endif
+
+    //Holds the generated meshes and the mesh caches
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid())
+    {
+        QTextStream(stderr) << "Could not make a temporary folder for the generated meshes\n";
+        return 1;
+    }
+
+    QStringList objFiles = parser.values(objFileOption);
+    if (objFiles.isEmpty())
+    {
+        for (const QString &size : parser.value(gridOption).split(','))
+        {
+            int gridSize = size.toInt();
+            QString filePath = tempDir.filePath(QString("grid%1.obj").arg(gridSize));
+            if (gridSize <= 0 || !writeGridObj(filePath, gridSize))
+            {
+                QTextStream(stderr) << "Could not write " << filePath << "\n";
+                return 1;
+            }
+            objFiles.append(filePath);
+        }
+    }
+
+    unsigned maxThreads = static_cast<unsigned>(std::max(0, parser.value(threadsOption).toInt()));
+    if (maxThreads == 0)
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    runner.addInfo("hardwareThreads", QString::number(std::thread::hardware_concurrency()));
+
+    for (const QString &filePath : objFiles)
+        benchObjFile(runner, filePath, tempDir.path(), maxThreads);
+
+    QString format = parser.value(formatOption).toLower();
+    QString text = format == "csv" ? runner.toCsv() : runner.toJson();
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QTextStream(stderr) << "Could not open " << file.fileName() << " for writing\n";
+            return 1;
+        }
+        QTextStream(&file) << text;
+    }
+    else
+    {
+        QTextStream(stdout) << text;
+    }
+
+    return 0;
+}
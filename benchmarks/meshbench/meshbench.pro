@@ -0,0 +1,34 @@
+# Headless benchmarks for mesh loading.
+# Build in release mode, then run ex. "meshbench --format csv -o results.csv"
+# or "meshbench --obj-file big.obj" to load your own files.
+
+QT          += core gui
+
+TEMPLATE    = app
+CONFIG      += c++17 console
+CONFIG      -= app_bundle
+
+TARGET      = meshbench
+
+include(../../GSL/gsl.pri)
+include(../common/common.pri)
+
+#The mesh loading code lives in the engine folder
+INCLUDEPATH += ../..
+
+HEADERS += \
+    ../../meshdata.h \
+    ../../meshfile.h \
+    ../../meshoptimizer.h \
+    ../../meshsimplifier.h \
+    ../../objreader.h \
+    ../../vertex.h \
+    legacyobjreader.h
+
+SOURCES += main.cpp \
+    ../../objreader.cpp \
+    ../../meshfile.cpp \
+    ../../meshoptimizer.cpp \
+    ../../meshsimplifier.cpp \
+    ../../vertex.cpp \
+    legacyobjreader.cpp
@@ -0,0 +1,582 @@
+//Checks and benchmarks for the texture file readers in textureformat.
+//Runs headless on DDS, KTX and bmp files generated in memory, and writes the results as JSON or CSV like gslbench.
+//The checks run first. Failures are written to stderr, and texturebench then exits with 1.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "benchmark.h"
+#include "textureformat.h"
+
+using bench::doNotOptimize;
+using bench::Runner;
+
+namespace
+{
+    using Bytes = std::vector<unsigned char>;
+
+    int failures = 0;
+
+    bool check(bool condition, const QString &what)
+    {
+        if (!condition)
+        {
+            QTextStream(stderr) << "FAILED: " << what << "\n";
+            failures++;
+        }
+        return condition;
+    }
+
+    void putUint16(Bytes &data, std::size_t offset, std::uint16_t value)
+    {
+        std::memcpy(&data[offset], &value, sizeof(value));
+    }
+
+    void putUint32(Bytes &data, std::size_t offset, std::uint32_t value)
+    {
+        std::memcpy(&data[offset], &value, sizeof(value));
+    }
+
+    std::size_t levelBytes(GLsizei width, GLsizei height, std::size_t blockBytes)
+    {
+        return static_cast<std::size_t>((width + 3) / 4) * static_cast<std::size_t>((height + 3) / 4) * blockBytes;
+    }
+
+    //The parsers log why each file is rejected, which is thousands of lines for the cut short files
+    void dropMessages(QtMsgType, const QMessageLogContext &, const QString &)
+    {
+    }
+
+    /**
+     * Every file shorter than a valid one must be rejected. Each prefix is copied to its own
+     * allocation, so a build with AddressSanitizer also catches reads past the end.
+     */
+    template <typename Read>
+    void checkTruncated(const QString &name, const Bytes &file, Read read)
+    {
+        QtMessageHandler previous = qInstallMessageHandler(dropMessages);
+        std::size_t accepted = file.size();
+        for (std::size_t size = 0; size < file.size() && accepted == file.size(); size++)
+        {
+            Bytes prefix(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(size));
+            if (read(prefix.data(), size))
+                accepted = size;
+        }
+        qInstallMessageHandler(previous);
+        check(accepted == file.size(), QString("%1 cut to %2 of %3 bytes is read as valid").arg(name).arg(accepted).arg(file.size()));
+    }
+
+    template <typename Read>
+    void checkRejected(const QString &name, const Bytes &file, Read read)
+    {
+        QtMessageHandler previous = qInstallMessageHandler(dropMessages);
+        bool ok = read(file.data(), file.size());
+        qInstallMessageHandler(previous);
+        check(!ok, name + " is read as valid");
+    }
+
+    //---------------------------------------- DDS and KTX ----------------------------------------
+
+    //Each mip level is filled with its level number, so checkLevels() can tell them apart
+    void appendLevel(Bytes &file, std::size_t bytes, unsigned level)
+    {
+        file.resize(file.size() + bytes, static_cast<unsigned char>(level));
+    }
+
+    /**
+     * A DDS file with levelsInFile mip levels after the header.
+     * fourCC "DX10" adds the DX10 header with dxgiFormat.
+     */
+    Bytes makeDds(GLsizei width, GLsizei height, std::uint32_t levelCount, bool mipMapFlag, const char *fourCC,
+                  std::uint32_t dxgiFormat, std::size_t blockBytes, unsigned levelsInFile)
+    {
+        bool dx10 = std::strcmp(fourCC, "DX10") == 0;
+        Bytes file(dx10 ? 148 : 128, 0);
+        std::memcpy(&file[0], "DDS ", 4);
+        putUint32(file, 4, 124);                                    //header size
+        putUint32(file, 8, 0x1007 | (mipMapFlag ? 0x20000 : 0));    //caps, height, width, pixel format (+ mip map count)
+        putUint32(file, 12, static_cast<std::uint32_t>(height));
+        putUint32(file, 16, static_cast<std::uint32_t>(width));
+        putUint32(file, 28, levelCount);
+        putUint32(file, 76, 32);                                    //pixel format size
+        putUint32(file, 80, 0x4);                                   //four cc flag
+        std::memcpy(&file[84], fourCC, 4);
+        if (dx10)
+        {
+            putUint32(file, 128, dxgiFormat);
+            putUint32(file, 132, 3);                                //texture 2D
+            putUint32(file, 140, 1);                                //array size
+        }
+
+        for (unsigned level = 0; level < levelsInFile; level++)
+            appendLevel(file, levelBytes(std::max(1, width >> level), std::max(1, height >> level), blockBytes), level);
+        return file;
+    }
+
+    //A KTX 1 file with keyValueBytes of key/value data before the levels
+    Bytes makeKtx(GLsizei width, GLsizei height, unsigned levels, GLenum format, std::size_t blockBytes,
+                  std::uint32_t keyValueBytes)
+    {
+        const unsigned char identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        Bytes file(64 + keyValueBytes, 0);
+        std::memcpy(&file[0], identifier, sizeof(identifier));
+        const std::uint32_t fields[13] = {0x04030201, 0, 1, 0, format, 0, static_cast<std::uint32_t>(width),
+                                          static_cast<std::uint32_t>(height), 0, 0, 1, levels, keyValueBytes};
+        std::memcpy(&file[12], fields, sizeof(fields));
+
+        for (unsigned level = 0; level < levels; level++)
+        {
+            std::size_t bytes = levelBytes(std::max(1, width >> level), std::max(1, height >> level), blockBytes);
+            file.resize(file.size() + 4);
+            putUint32(file, file.size() - 4, static_cast<std::uint32_t>(bytes));
+            appendLevel(file, (bytes + 3) / 4 * 4, level);
+        }
+        return file;
+    }
+
+    /**
+     * Checks the format and that the levels are where the generators put them:
+     * one after the other from firstOffset, with a 4 byte size in front of each for KTX.
+     */
+    void checkLevels(const QString &name, const CompressedImage &image, const Bytes &file, GLenum format,
+                     GLsizei width, GLsizei height, unsigned levels, std::size_t firstOffset, bool sizeInFront)
+    {
+        if (!check(image.format == format, name + ": format is " + textureformat::formatName(image.format)) ||
+            !check(image.levels.size() == levels, QString("%1: %2 levels instead of %3").arg(name).arg(image.levels.size()).arg(levels)))
+            return;
+
+        std::size_t blockBytes = textureformat::blockBytes(format);
+        std::size_t offset = firstOffset;
+        for (unsigned level = 0; level < levels; level++)
+        {
+            const CompressedLevel &read = image.levels[level];
+            GLsizei levelWidth = std::max(1, width >> level);
+            GLsizei levelHeight = std::max(1, height >> level);
+            std::size_t bytes = levelBytes(levelWidth, levelHeight, blockBytes);
+            if (sizeInFront)
+                offset += 4;
+
+            QString where = QString("%1 level %2").arg(name).arg(level);
+            check(read.width == levelWidth && read.height == levelHeight,
+                  QString("%1 is %2x%3").arg(where).arg(read.width).arg(read.height));
+            check(read.size == bytes, QString("%1 has %2 bytes instead of %3").arg(where).arg(read.size).arg(bytes));
+            check(read.data == file.data() + offset,
+                  QString("%1 is at offset %2 instead of %3").arg(where).arg(read.data - file.data()).arg(offset));
+            check(read.data[0] == level && read.data[read.size - 1] == level, where + " has another level's data");
+            offset += (bytes + 3) / 4 * 4;
+        }
+    }
+
+    void checkDds()
+    {
+        auto readDds = [](const unsigned char *data, std::size_t size) {
+            CompressedImage image;
+            return textureformat::readDds(data, size, image, "truncated.dds");
+        };
+
+        struct Case
+        {
+            const char *name;
+            GLsizei width, height;
+            std::uint32_t levelCount;
+            bool mipMapFlag;
+            const char *fourCC;
+            std::uint32_t dxgiFormat;
+            GLenum format;
+            unsigned levels;            //expected
+        };
+        const Case cases[] = {
+            {"DXT1 with mips", 64, 32, 7, true, "DXT1", 0, textureformat::BC1, 7},
+            {"DXT5 without the mip map flag", 30, 30, 5, false, "DXT5", 0, textureformat::BC3, 1},
+            {"ATI2", 8, 8, 1, true, "ATI2", 0, textureformat::BC5, 1},
+            {"DX10 BC7", 30, 30, 3, true, "DX10", 98, textureformat::BC7, 3},
+            {"DX10 BC1 sRGB with too many mips", 16, 16, 9, true, "DX10", 72, textureformat::BC1_SRGB, 5},
+        };
+
+        for (const Case &c : cases)
+        {
+            std::size_t blockBytes = textureformat::blockBytes(c.format);
+            Bytes file = makeDds(c.width, c.height, c.levelCount, c.mipMapFlag, c.fourCC, c.dxgiFormat, blockBytes, c.levels);
+            QString name = QString("DDS ") + c.name;
+
+            CompressedImage image;
+            if (check(textureformat::isDds(file.data(), file.size()) &&
+                      textureformat::readDds(file.data(), file.size(), image, c.name), name + " is not read"))
+            {
+                std::size_t firstOffset = std::strcmp(c.fourCC, "DX10") == 0 ? 148 : 128;
+                checkLevels(name, image, file, c.format, c.width, c.height, c.levels, firstOffset, false);
+            }
+            checkTruncated(name, file, readDds);
+        }
+
+        Bytes valid = makeDds(16, 16, 1, true, "DXT1", 0, 8, 1);
+        Bytes file = valid;
+        putUint32(file, 4, 120);
+        checkRejected("DDS with the wrong header size", file, readDds);
+        file = valid;
+        putUint32(file, 112, 0x200);
+        checkRejected("DDS cube map", file, readDds);
+        file = valid;
+        putUint32(file, 80, 0x40);
+        checkRejected("DDS without a four cc", file, readDds);
+        file = valid;
+        std::memcpy(&file[84], "DXT3", 4);
+        checkRejected("DDS DXT3", file, readDds);
+        file = valid;
+        putUint32(file, 16, 0);
+        checkRejected("DDS 0 pixels wide", file, readDds);
+
+        Bytes dx10 = makeDds(16, 16, 1, true, "DX10", 98, 16, 1);
+        file = dx10;
+        putUint32(file, 140, 2);
+        checkRejected("DDS DX10 array", file, readDds);
+        file = dx10;
+        putUint32(file, 128, 28);  //DXGI_FORMAT_R8G8B8A8_UNORM
+        checkRejected("DDS DX10 uncompressed", file, readDds);
+    }
+
+    void checkKtx()
+    {
+        auto readKtx = [](const unsigned char *data, std::size_t size) {
+            CompressedImage image;
+            return textureformat::readKtx(data, size, image, "truncated.ktx");
+        };
+
+        struct Case
+        {
+            const char *name;
+            GLsizei width, height;
+            unsigned levels;
+            GLenum format;
+            std::uint32_t keyValueBytes;
+        };
+        const Case cases[] = {
+            {"BC5 with mips and key/value data", 32, 16, 6, textureformat::BC5, 12},
+            {"BC7 sRGB not a multiple of 4", 5, 3, 1, textureformat::BC7_SRGB, 0},
+            {"BC1 with mips", 64, 64, 7, textureformat::BC1, 4},
+        };
+
+        for (const Case &c : cases)
+        {
+            Bytes file = makeKtx(c.width, c.height, c.levels, c.format, textureformat::blockBytes(c.format), c.keyValueBytes);
+            QString name = QString("KTX ") + c.name;
+
+            CompressedImage image;
+            if (check(textureformat::isKtx(file.data(), file.size()) &&
+                      textureformat::readKtx(file.data(), file.size(), image, c.name), name + " is not read"))
+            {
+                checkLevels(name, image, file, c.format, c.width, c.height, c.levels, 64 + c.keyValueBytes, true);
+            }
+            checkTruncated(name, file, readKtx);
+        }
+
+        Bytes valid = makeKtx(16, 16, 1, textureformat::BC3, 16, 0);
+        Bytes file = valid;
+        putUint32(file, 12, 0x01020304);
+        checkRejected("KTX with the other endianness", file, readKtx);
+        file = valid;
+        putUint32(file, 16, GL_UNSIGNED_BYTE);
+        checkRejected("KTX uncompressed", file, readKtx);
+        file = valid;
+        putUint32(file, 28, GL_RGBA8);
+        checkRejected("KTX RGBA8", file, readKtx);
+        file = valid;
+        putUint32(file, 52, 6);
+        checkRejected("KTX cube map", file, readKtx);
+        file = valid;
+        putUint32(file, 64, 128);
+        checkRejected("KTX with a level of the wrong size", file, readKtx);
+        file = valid;
+        putUint32(file, 60, 0xFFFFFFF0u);
+        checkRejected("KTX with too much key/value data", file, readKtx);
+    }
+
+    //---------------------------------------- Bitmaps ----------------------------------------
+
+    //The colour of a pixel, with y counted from the bottom row
+    std::array<unsigned char, 4> pixelColour(GLsizei x, GLsizei y)
+    {
+        return {static_cast<unsigned char>(x * 10 + 1), static_cast<unsigned char>(y * 10 + 2),
+                static_cast<unsigned char>(x + y + 3), 200};
+    }
+
+    /**
+     * A 24 or 32 bit bitmap. A negative height stores the rows top-down.
+     * masks are red, green, blue and alpha for BI_BITFIELDS. They are part of the bigger headers,
+     * or follow the 40 byte one.
+     */
+    Bytes makeBitmap(int bitCount, GLsizei width, GLsizei height, std::uint32_t headerSize, std::uint32_t compression,
+                     const std::vector<std::uint32_t> &masks)
+    {
+        GLsizei rows = std::abs(height);
+        std::size_t rowSize = (static_cast<std::size_t>(width) * static_cast<std::size_t>(bitCount) + 31) / 32 * 4;
+        std::size_t pixelOffset = 14 + headerSize + (headerSize == 40 ? masks.size() * 4 : 0);
+        Bytes file(pixelOffset + rowSize * static_cast<std::size_t>(rows), 0xEE);
+
+        file[0] = 'B';
+        file[1] = 'M';
+        putUint32(file, 2, static_cast<std::uint32_t>(file.size()));
+        putUint32(file, 6, 0);
+        putUint32(file, 10, static_cast<std::uint32_t>(pixelOffset));
+        std::fill(file.begin() + 14, file.begin() + static_cast<std::ptrdiff_t>(pixelOffset), 0);
+        putUint32(file, 14, headerSize);
+        putUint32(file, 18, static_cast<std::uint32_t>(width));
+        putUint32(file, 22, static_cast<std::uint32_t>(height));
+        putUint16(file, 26, 1);
+        putUint16(file, 28, static_cast<std::uint16_t>(bitCount));
+        putUint32(file, 30, compression);
+        for (std::size_t i = 0; i < masks.size(); i++)
+            putUint32(file, 54 + i * 4, masks[i]);
+
+        //Without masks the pixels are b, g, r (, unused)
+        std::vector<std::uint32_t> channelMasks = masks;
+        if (channelMasks.empty())
+            channelMasks = {0x00FF0000, 0x0000FF00, 0x000000FF};
+
+        for (GLsizei row = 0; row < rows; row++)
+        {
+            GLsizei y = height < 0 ? rows - 1 - row : row;
+            unsigned char *rowData = &file[pixelOffset + static_cast<std::size_t>(row) * rowSize];
+            for (GLsizei x = 0; x < width; x++)
+            {
+                std::array<unsigned char, 4> colour = pixelColour(x, y);
+                std::uint32_t pixel = 0;
+                for (std::size_t channel = 0; channel < channelMasks.size(); channel++)
+                {
+                    for (int shift = 0; shift < 32; shift += 8)
+                    {
+                        if ((channelMasks[channel] >> shift) & 1u)
+                            pixel |= std::uint32_t{colour[channel]} << shift;
+                    }
+                }
+                std::memcpy(rowData + static_cast<std::size_t>(x) * static_cast<std::size_t>(bitCount / 8), &pixel,
+                            static_cast<std::size_t>(bitCount / 8));
+            }
+        }
+        return file;
+    }
+
+    //The pixels copyBitmap() made must be bottom-up, in the format it says
+    void checkCopiedPixels(const QString &name, const BitmapImage &image, bool alpha)
+    {
+        int bytesPerPixel = image.format == GL_BGR ? 3 : 4;
+        for (GLsizei y = 0; y < image.height; y++)
+        {
+            for (GLsizei x = 0; x < image.width; x++)
+            {
+                const unsigned char *pixel = image.pixels + static_cast<std::size_t>(y) * image.rowSize +
+                                             static_cast<std::size_t>(x * bytesPerPixel);
+                bool bgr = image.format == GL_BGR || image.format == GL_BGRA;
+                std::array<unsigned char, 4> read = {pixel[bgr ? 2 : 0], pixel[1], pixel[bgr ? 0 : 2],
+                                                     bytesPerPixel == 4 ? pixel[3] : static_cast<unsigned char>(200)};
+                std::array<unsigned char, 4> expected = pixelColour(x, y);
+                if (!alpha)
+                    read[3] = expected[3];
+                if (!check(read == expected, QString("%1: pixel %2, %3 has the wrong colour").arg(name).arg(x).arg(y)))
+                    return;
+            }
+        }
+    }
+
+    void checkBitmaps()
+    {
+        auto readBitmap = [](const unsigned char *data, std::size_t size) {
+            BitmapImage image;
+            return textureformat::readBitmap(data, size, image, "truncated.bmp");
+        };
+
+        constexpr std::uint32_t BI_RGB = 0, BI_BITFIELDS = 3, BI_ALPHABITFIELDS = 6;
+        struct Case
+        {
+            const char *name;
+            int bitCount;
+            GLsizei width, height;
+            std::uint32_t headerSize;
+            std::uint32_t compression;
+            std::vector<std::uint32_t> masks;
+            GLint internalFormat;       //expected
+            GLenum format;
+            bool shuffle;
+            std::array<unsigned char, 4> order;
+        };
+        const Case cases[] = {
+            {"24 bit", 24, 13, 7, 40, BI_RGB, {}, GL_RGB8, GL_BGR, false, {0, 1, 2, 3}},
+            {"24 bit top-down", 24, 13, -7, 40, BI_RGB, {}, GL_RGB8, GL_BGR, false, {0, 1, 2, 3}},
+            {"32 bit BI_RGB", 32, 9, 5, 40, BI_RGB, {}, GL_RGB8, GL_BGRA, false, {0, 1, 2, 3}},
+            {"32 bit BI_BITFIELDS BGRA top-down", 32, 9, -5, 108, BI_BITFIELDS,
+             {0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000}, GL_RGBA8, GL_BGRA, false, {0, 1, 2, 3}},
+            {"32 bit BI_BITFIELDS RGBA", 32, 9, 5, 124, BI_BITFIELDS,
+             {0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000}, GL_RGBA8, GL_RGBA, false, {0, 1, 2, 3}},
+            {"32 bit BI_BITFIELDS ARGB", 32, 21, 5, 108, BI_BITFIELDS,
+             {0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF}, GL_RGBA8, GL_RGBA, true, {1, 2, 3, 0}},
+            {"32 bit BI_BITFIELDS XRGB, masks after the basic header, top-down", 32, 33, -6, 40, BI_BITFIELDS,
+             {0x0000FF00, 0x00FF0000, 0xFF000000}, GL_RGB8, GL_RGBA, true, {1, 2, 3, 0}},
+            {"32 bit BI_ALPHABITFIELDS ABGR", 32, 17, 3, 40, BI_ALPHABITFIELDS,
+             {0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF}, GL_RGBA8, GL_RGBA, true, {3, 2, 1, 0}},
+        };
+
+        for (const Case &c : cases)
+        {
+            Bytes file = makeBitmap(c.bitCount, c.width, c.height, c.headerSize, c.compression, c.masks);
+            QString name = QString("bmp ") + c.name;
+
+            BitmapImage image;
+            if (check(textureformat::readBitmap(file.data(), file.size(), image, c.name), name + " is not read"))
+            {
+                std::size_t pixelOffset = 14 + c.headerSize + (c.headerSize == 40 ? c.masks.size() * 4 : 0);
+                std::size_t rowSize = (static_cast<std::size_t>(c.width) * static_cast<std::size_t>(c.bitCount) + 31) / 32 * 4;
+                std::array<unsigned char, 4> order = {image.order[0], image.order[1], image.order[2], image.order[3]};
+                check(image.pixels == file.data() + pixelOffset, name + ": the pixels are at the wrong offset");
+                check(image.width == c.width && image.height == std::abs(c.height) && image.topDown == (c.height < 0),
+                      QString("%1: read as %2x%3").arg(name).arg(image.width).arg(image.topDown ? -image.height : image.height));
+                check(image.rowSize == rowSize, QString("%1: rows of %2 bytes").arg(name).arg(image.rowSize));
+                check(image.internalFormat == c.internalFormat && image.format == c.format,
+                      QString("%1: formats 0x%2, 0x%3").arg(name).arg(QString::number(image.internalFormat, 16))
+                                                      .arg(QString::number(image.format, 16)));
+                check(image.shuffle == c.shuffle && (!c.shuffle || order == c.order), name + ": wrong channel shuffle");
+
+                std::vector<unsigned char> copy(textureformat::bitmapSize(image));
+                BitmapImage copied = textureformat::copyBitmap(image, copy.data());
+                check(!copied.topDown && !copied.shuffle && copied.pixels == copy.data(), name + ": copy is not plain bottom-up");
+                checkCopiedPixels(name, copied, c.internalFormat == GL_RGBA8);
+            }
+            checkTruncated(name, file, readBitmap);
+        }
+
+        Bytes valid = makeBitmap(32, 4, 4, 108, BI_BITFIELDS, {0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000});
+        Bytes file = valid;
+        file[1] = 'A';
+        checkRejected("bmp without the BM magic", file, readBitmap);
+        file = valid;
+        putUint32(file, 14, 12);
+        checkRejected("bmp with an OS/2 header", file, readBitmap);
+        file = valid;
+        putUint16(file, 28, 16);
+        checkRejected("bmp 16 bit", file, readBitmap);
+        file = valid;
+        putUint32(file, 30, 1);
+        checkRejected("bmp RLE compressed", file, readBitmap);
+        file = valid;
+        putUint32(file, 54, 0x00FFF000);
+        checkRejected("bmp with a channel that is not whole bytes", file, readBitmap);
+        file = valid;
+        putUint32(file, 58, 0x00FF0000);
+        checkRejected("bmp with overlapping channels", file, readBitmap);
+        file = valid;
+        putUint32(file, 18, 0);
+        checkRejected("bmp 0 pixels wide", file, readBitmap);
+        file = valid;
+        putUint32(file, 10, 0xFFFFFFF0u);
+        checkRejected("bmp with the pixels past the end", file, readBitmap);
+        file = makeBitmap(24, 4, 4, 40, BI_BITFIELDS, {0x00FF0000, 0x0000FF00, 0x000000FF});
+        checkRejected("bmp 24 bit with channel masks", file, readBitmap);
+    }
+
+    //---------------------------------------- Timing ----------------------------------------
+
+    void benchTextureFormat(Runner &runner)
+    {
+        Bytes dds = makeDds(1024, 1024, 11, true, "DXT1", 0, 8, 11);
+        runner.run("textureformat", "readDds", [&](std::int64_t) {
+            CompressedImage image;
+            textureformat::readDds(dds.data(), dds.size(), image, "bench.dds");
+            doNotOptimize(image);
+        }, "1024x1024 BC1 with 11 levels");
+
+        Bytes ktx = makeKtx(1024, 1024, 11, textureformat::BC7, 16, 64);
+        runner.run("textureformat", "readKtx", [&](std::int64_t) {
+            CompressedImage image;
+            textureformat::readKtx(ktx.data(), ktx.size(), image, "bench.ktx");
+            doNotOptimize(image);
+        }, "1024x1024 BC7 with 11 levels");
+
+        //The copy into the pixel buffer object TextureCache does on its loader thread
+        struct Case
+        {
+            const char *variant;
+            Bytes file;
+        };
+        const Case cases[] = {
+            {"2048x2048 24 bit top-down", makeBitmap(24, 2048, -2048, 40, 0, {})},
+            {"2048x2048 32 bit ARGB", makeBitmap(32, 2048, 2048, 108, 3, {0x0000FF00, 0x00FF0000, 0xFF000000, 0x000000FF})},
+        };
+        for (const Case &c : cases)
+        {
+            BitmapImage image;
+            if (!textureformat::readBitmap(c.file.data(), c.file.size(), image, c.variant))
+                continue;
+
+            runner.run("textureformat", "readBitmap", [&](std::int64_t) {
+                BitmapImage read;
+                textureformat::readBitmap(c.file.data(), c.file.size(), read, c.variant);
+                doNotOptimize(read);
+            }, c.variant);
+
+            std::vector<unsigned char> copy(textureformat::bitmapSize(image));
+            if (bench::Result *result = runner.run("textureformat", "copyBitmap", [&](std::int64_t) {
+                    doNotOptimize(textureformat::copyBitmap(image, copy.data()));
+                }, c.variant))
+                result->bytesPerOp = static_cast<double>(copy.size());
+        }
+    }
+} //namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("texturebench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Checks and benchmarks for the texture file readers");
+    parser.addHelpOption();
+    QCommandLineOption formatOption("format", "Output format: json or csv.", "format", "json");
+    QCommandLineOption outputOption({"o", "output"}, "Write the results to <file> instead of stdout.", "file");
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose group/name contains <text>.", "text");
+    QCommandLineOption repetitionsOption("repetitions", "Timed batches per benchmark.", "count", "9");
+    QCommandLineOption minTimeOption("min-time", "Shortest batch, in milliseconds.", "ms", "20");
+    parser.addOptions({formatOption, outputOption, filterOption, repetitionsOption, minTimeOption});
+    parser.process(app);
+
+    //The readers parse files from disk, so they are checked before anything is timed
+    checkDds();
+    checkKtx();
+    checkBitmaps();
+
+    Runner runner(parser.value(filterOption), parser.value(repetitionsOption).toInt(),
+                  parser.value(minTimeOption).toDouble());
+    runner.addInfo("checksFailed", QString::number(failures));
+#ifdef QT_DEBUG
+    runner.addInfo("build", "debug");
+#else
+    runner.addInfo("build", "release");
+#endif
+
+    benchTextureFormat(runner);
+
+    QString format = parser.value(formatOption).toLower();
+    QString text = format == "csv" ? runner.toCsv() : runner.toJson();
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QTextStream(stderr) << "Could not open " << file.fileName() << " for writing\n";
+            return 1;
+        }
+        QTextStream(&file) << text;
+    }
+    else
+    {
+        QTextStream(stdout) << text;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+# Headless checks and benchmarks for the texture file readers.
+# Build in release mode, then run ex. "texturebench --format csv -o results.csv".
+# The checks always run, and texturebench exits with 1 if any of them fails.
+
+QT          += core gui
+
+TEMPLATE    = app
+CONFIG      += c++17 console
+CONFIG      -= app_bundle
+
+TARGET      = texturebench
+
+include(../../GSL/gsl.pri)
+include(../common/common.pri)
+
+#The texture readers live in the engine folder
+INCLUDEPATH += ../..
+
+HEADERS += \
+    ../../textureformat.h
+
+SOURCES += main.cpp \
+    ../../textureformat.cpp
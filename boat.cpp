@@ -1,4 +1,5 @@
 #include "boat.h"
+#include "vertexformat.h"
 
 Boat::Boat(gsl::Vector3D startPosition) : mPosition(startPosition), mStartPosition(startPosition)
 {
@@ -16,8 +17,10 @@ Boat::Boat(gsl::Vector3D startPosition) : mPosition(startPosition), mStartPositi
                      1, 3, 2,
                      3, 0, 2,
                      0, 3, 1});
+    mLocalBounds = Bounds::fromVertices(mVertices.data(), mVertices.size());
     mMatrix.setToIdentity();
     mMatrix.translate(mPosition);
+    matrixChanged();
 }
 void Boat::init()
 {
@@ -33,32 +36,23 @@ void Boat::init()
 
     glBufferData(GL_ARRAY_BUFFER, mVertices.size() * sizeof(Vertex), mVertices.data(), GL_STATIC_DRAW);
 
-    // 1rst attribute buffer : vertices
-    glBindBuffer(GL_ARRAY_BUFFER, mVBO);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)0);
-    glEnableVertexAttribArray(0);
-
-    // 2nd attribute buffer : colors
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)(3 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-
-    // 3rd attribute buffer : uvs
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)(6 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(2);
+    //The boat is tiny and moves around, so it keeps the full float layout
+    vertexformat::setVertexAttributes(*this, VertexLayout::Float);
 
     //Second buffer - holds the indices (Element Array Buffer - EAB):
     glGenBuffers(1, &mEAB);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEAB);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndices.size() * sizeof(GLuint), mIndices.data(), GL_STATIC_DRAW);
+    mIndexType = vertexformat::uploadIndices(*this, mIndices.data(), mIndices.size(), mVertices.size());
 
     glBindVertexArray(0);
+    geometryUploaded();
 }
 void Boat::draw()
 {
     glUseProgram(mMaterial.mShader->getProgram());
     glBindVertexArray(mVAO);
     mMaterial.mShader->transmitUniformData(&mMatrix, &mMaterial);
-    glDrawElements(GL_TRIANGLES, mIndices.size(), GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES, mIndexCount, mIndexType, nullptr);
 }
 void Boat::Tick(float deltaTime)
 {
@@ -66,7 +60,8 @@ void Boat::Tick(float deltaTime)
     mPosition += mForward * mSpeed * deltaTime;
     mMatrix.setToIdentity();
     mMatrix.translate(mPosition);
-    mMatrix.rotateY(-mYaw);
+    mMatrix.rotate(mOrientation);
+    matrixChanged();
 }
 
 void Boat::MoveInput(Qt::Key key, float deltaTime)
@@ -85,8 +80,9 @@ void Boat::Reset()
 {
     mSpeed = 0.f;
     mMatrix.setToIdentity();
+    matrixChanged();
     mPosition = mStartPosition;
-    mYaw = 0.f;
+    mOrientation = gsl::Quaternion();
     UpdateForwardVector();
 }
 
@@ -100,19 +96,19 @@ void Boat::SetPosition(gsl::Vector3D newPosition)
     mPosition = newPosition;
     mMatrix.setToIdentity();
     mMatrix.translate(mPosition);
-    mMatrix.rotateY(-mYaw);
+    mMatrix.rotate(mOrientation);
+    matrixChanged();
 }
 void Boat::Rotate(float degrees)
 {
     // rotate around mUp
-    mYaw -= degrees;
+    mOrientation = gsl::Quaternion::fromAxisAngle(mUp, -degrees) * mOrientation;
+    mOrientation.normalize();
     UpdateForwardVector();
 }
 void Boat::UpdateForwardVector()
 {
-    mRight = gsl::Vector3D(1.f, 0.f, 0.f);
-    mRight.rotateY(mYaw);
-    mRight.normalize();
+    mRight = mOrientation.rotate(gsl::Vector3D(1.f, 0.f, 0.f));
     mForward = mUp ^ mRight;
     UpdateRightVector();
 }
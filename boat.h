@@ -2,6 +2,7 @@
 #define BOAT_H
 
 #include "visualobject.h"
+#include "quaternion.h"
 
 class Boat : public VisualObject {
 public:
@@ -39,7 +40,7 @@ private:
     gsl::Vector3D mRight{1.f, 0.f, 0.f};
     gsl::Vector3D mUp{0.f, 1.f, 0.f};
 
-    float mYaw{0.f};
+    gsl::Quaternion mOrientation;
 
     gsl::Vector3D mPosition{0.f, 0.f, 0.f};
     gsl::Vector3D mStartPosition{0.f, 10.f, 0.f};
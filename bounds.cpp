@@ -0,0 +1,67 @@
+#include "innpch.h"
+#include "bounds.h"
+#include <algorithm>
+#include <cmath>
+
+Bounds Bounds::fromVertices(const Vertex *vertices, std::size_t count)
+{
+    Bounds bounds;
+    if (count == 0)
+        return bounds;
+
+    bounds.mMin = vertices[0].xyz();
+    bounds.mMax = bounds.mMin;
+    for (std::size_t i = 1; i < count; i++)
+    {
+        const gsl::Vector3D &position = vertices[i].xyz();
+        bounds.mMin = gsl::Vector3D(std::min(bounds.mMin.x, position.x), std::min(bounds.mMin.y, position.y),
+                                    std::min(bounds.mMin.z, position.z));
+        bounds.mMax = gsl::Vector3D(std::max(bounds.mMax.x, position.x), std::max(bounds.mMax.y, position.y),
+                                    std::max(bounds.mMax.z, position.z));
+    }
+
+    bounds.mCenter = (bounds.mMin + bounds.mMax) * 0.5f;
+    float radiusSquared = 0.f;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        gsl::Vector3D offset = vertices[i].xyz() - bounds.mCenter;
+        radiusSquared = std::max(radiusSquared, gsl::Vector3D::dot(offset, offset));
+    }
+    bounds.mRadius = std::sqrt(radiusSquared);
+    return bounds;
+}
+
+Bounds Bounds::transformed(const gsl::Matrix4x4 &matrix) const
+{
+    if (isEmpty())
+        return *this;
+
+    //Each corner of the new box is the translation plus the smallest (or largest)
+    //contribution of every matrix element (Arvo, Graphics Gems 1990)
+    Bounds result;
+    GLfloat min[3] = {mMin.x, mMin.y, mMin.z};
+    GLfloat max[3] = {mMax.x, mMax.y, mMax.z};
+    GLfloat newMin[3];
+    GLfloat newMax[3];
+    float largestScale = 0.f;
+    for (int row = 0; row < 3; row++)
+    {
+        newMin[row] = newMax[row] = matrix(row, 3);
+        for (int column = 0; column < 3; column++)
+        {
+            GLfloat a = matrix(row, column) * min[column];
+            GLfloat b = matrix(row, column) * max[column];
+            newMin[row] += std::min(a, b);
+            newMax[row] += std::max(a, b);
+        }
+
+        gsl::Vector3D axis(matrix(0, row), matrix(1, row), matrix(2, row));
+        largestScale = std::max(largestScale, axis.length());
+    }
+    result.mMin = gsl::Vector3D(newMin[0], newMin[1], newMin[2]);
+    result.mMax = gsl::Vector3D(newMax[0], newMax[1], newMax[2]);
+
+    result.mCenter = (matrix * gsl::Vector4D(mCenter, 1.f)).toVector3D();
+    result.mRadius = mRadius * largestScale;
+    return result;
+}
@@ -0,0 +1,32 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <cstddef>
+#include "vertex.h"
+#include "matrix4x4.h"
+
+/**
+ * Axis aligned box and sphere around a mesh - the cheap spatial data for culling, LOD and picking.
+ * Empty (isEmpty()) until made from some vertices.
+ */
+struct Bounds
+{
+    gsl::Vector3D mMin{1.f, 1.f, 1.f};      //empty: min is above max
+    gsl::Vector3D mMax{-1.f, -1.f, -1.f};
+    gsl::Vector3D mCenter;                  //of the sphere
+    float mRadius{0.f};
+
+    bool isEmpty() const { return mMin.x > mMax.x; }
+
+    //The sphere is centered in the box, with the radius reaching the farthest vertex
+    static Bounds fromVertices(const Vertex *vertices, std::size_t count);
+
+    /**
+     * Bounds of the same volume after transforming it by matrix. The box is the smallest box
+     * around the transformed box, the sphere radius is scaled by the largest scale in the matrix.
+     * Both can get larger than the tightest bounds of the transformed vertices, never smaller.
+     */
+    Bounds transformed(const gsl::Matrix4x4 &matrix) const;
+};
+
+#endif // BOUNDS_H
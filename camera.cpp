@@ -5,9 +5,6 @@ Camera::Camera()
 {
     mViewMatrix.setToIdentity();
     mProjectionMatrix.setToIdentity();
-
-    mYawMatrix.setToIdentity();
-    mPitchMatrix.setToIdentity();
 }
 
 void Camera::pitch(float degrees)
@@ -33,28 +30,25 @@ void Camera::updateRightVector()
 
 void Camera::updateForwardVector()
 {
-    mRight = gsl::Vector3D(1.f, 0.f, 0.f);
-    mRight.rotateY(mYaw);
-    mRight.normalize();
-    mUp = gsl::Vector3D(0.f, 1.f, 0.f);
-    mUp.rotateX(mPitch);
-    mUp.normalize();
+    gsl::Quaternion yawRotation = gsl::Quaternion::fromAxisAngle(gsl::up(), mYaw);
+    gsl::Quaternion pitchRotation = gsl::Quaternion::fromAxisAngle(gsl::right(), mPitch);
+
+    mRight = yawRotation.rotate(gsl::right());
+    mUp = pitchRotation.rotate(gsl::up());
     mForward = mUp ^ mRight;
 
     updateRightVector();
+
+    //The view matrix rotates the world the opposite way of the camera: first yaw, then pitch
+    mViewRotation = pitchRotation.conjugate() * yawRotation.conjugate();
+    mViewRotation.normalize();
 }
 
 void Camera::update()
 {
-    mYawMatrix.setToIdentity();
-    mPitchMatrix.setToIdentity();
-
-    mPitchMatrix.rotateX(mPitch);
-    mYawMatrix.rotateY(mYaw);
-
     mPosition -= mForward * mSpeed;
 
-    mViewMatrix = mPitchMatrix * mYawMatrix;
+    mViewMatrix = mViewRotation.toMatrix4();
     mViewMatrix.translate(-mPosition);
 }
 
@@ -38,8 +38,8 @@ private:
     float mPitch{0.f};
     float mYaw{0.f};
 
-    gsl::Matrix4x4 mYawMatrix;
-    gsl::Matrix4x4 mPitchMatrix;
+    //Inverse of the camera orientation - the rotation part of mViewMatrix
+    gsl::Quaternion mViewRotation;
 
     float mSpeed{0.f}; //camera will move by this speed along the mForward vector
 };
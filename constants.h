@@ -8,6 +8,7 @@ namespace gsl //Game School Lib
 const std::string projectFolderName{"../Boat/"};
 const std::string assetFilePath{projectFolderName + "Assets/"};
 const std::string shaderFilePath{projectFolderName + "Shaders/"};
+const std::string meshCacheFilePath{assetFilePath + "Meshes/Cache/"};   //binary .mesh files made from the meshes
 } // namespace gsl
 
 #endif // CONSTANTS_H
@@ -1,6 +1,7 @@
 #include "innpch.h"
 #include "material.h"
 #include "textureshader.h"
+#include "texture.h"
 
 Material::Material()
 {
@@ -17,6 +18,11 @@ void Material::setTextureUnit(const GLuint &textureUnit)
     mTextureUnit = textureUnit;
 }
 
+void Material::setTexture(std::shared_ptr<Texture> texture)
+{
+    mTexture = std::move(texture);
+}
+
 void Material::setShader(Shader *shader)
 {
     mShader = shader;
@@ -1,8 +1,11 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
+#include <memory>
 #include "vector3d.h"
 
+class Texture;
+
 class Material
 {
 public:
@@ -10,10 +13,12 @@ public:
 
     void setShader(class Shader *shader);
     void setTextureUnit(const GLuint &textureUnit);
+    void setTexture(std::shared_ptr<Texture> texture);
     void setColor(const gsl::Vector3D &color);
 
     gsl::Vector3D mObjectColor{1.f, 1.f, 1.f};
-    GLuint mTextureUnit{0};     //the actual texture to put into the uniform
+    std::shared_ptr<Texture> mTexture;  //from TextureCache, shared with other materials
+    GLuint mTextureUnit{0};     //the unit mTexture is bound to when drawn, put into the uniform
     Shader *mShader{nullptr};
 };
 
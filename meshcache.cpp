@@ -0,0 +1,342 @@
+#include "innpch.h"
+#include "meshcache.h"
+#include "objreader.h"
+#include "meshoptimizer.h"
+#include "meshsimplifier.h"
+#include "camera.h"
+#include <QDir>
+#include <QFileInfo>
+
+MeshCache::MeshCache()
+{
+    //must call this to use OpenGL functions
+    initializeOpenGLFunctions();
+}
+
+MeshCache::~MeshCache()
+{
+    //Meshes still queued are never read. One being read is finished first.
+    if (mLoader.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopLoader = true;
+        }
+        mWakeLoader.notify_one();
+        mLoader.join();
+    }
+
+    for (auto &entry : mMeshes)
+    {
+        MeshResource &mesh = *entry.second;
+        glDeleteVertexArrays(1, &mesh.mVAO);
+        glDeleteBuffers(1, &mesh.mVBO);
+        glDeleteBuffers(1, &mesh.mEAB);
+    }
+}
+
+MeshResource *MeshCache::acquire(const std::string &filename, Residency residency)
+{
+    std::string fileWithPath = gsl::assetFilePath + "Meshes/" + filename;
+
+    std::unique_ptr<MeshResource> &entry = mMeshes[fileWithPath];
+    if (!entry)
+    {
+        entry = std::make_unique<MeshResource>();
+        entry->mFilePath = fileWithPath;
+        entry->mFileName = filename;
+        entry->mLoading = true;
+        mLoadsInFlight++;
+
+        if (!mLoader.joinable())
+            mLoader = std::thread(&MeshCache::loaderLoop, this);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mLoadQueue.push_back(entry.get());
+        }
+        mWakeLoader.notify_one();
+    }
+    if (static_cast<int>(residency) > static_cast<int>(entry->mResidency))
+        entry->mResidency = residency;
+    entry->mReferenceCount++;
+    return entry.get();
+}
+
+void MeshCache::loaderLoop()
+{
+    for (;;)
+    {
+        MeshResource *mesh;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeLoader.wait(lock, [this] { return mStopLoader || !mLoadQueue.empty(); });
+            if (mStopLoader)
+                return;
+            mesh = mLoadQueue.front();
+            mLoadQueue.pop_front();
+        }
+
+        read(*mesh);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoaded.push_back(mesh);
+    }
+}
+
+void MeshCache::update()
+{
+    //The budget is checked before each upload, so at least one mesh is uploaded even if it is larger
+    std::size_t uploadedBytes = 0;
+    while (mLoadsInFlight > 0 && (uploadedBytes == 0 || uploadedBytes < mUploadBudget))
+    {
+        MeshResource *mesh;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mLoaded.empty())
+                return;
+            mesh = mLoaded.front();
+            mLoaded.pop_front();
+        }
+        mesh->mLoading = false;
+        mLoadsInFlight--;
+
+        //Released by all its users while it was loading
+        if (mesh->mReferenceCount == 0)
+        {
+            destroy(mesh);
+            continue;
+        }
+        uploadedBytes += upload(mesh);
+        if (mLoadsInFlight == 0)
+            logMemoryReport();
+    }
+}
+
+//Runs on the loader thread
+void MeshCache::read(MeshResource &mesh)
+{
+    const std::string &filename = mesh.mFileName;
+    std::string cacheFile = cacheFilePath(mesh);
+
+    //Use the binary cache if it is up to date - no parsing, upload() goes straight from the mapping
+    if (mesh.mMeshFile.open(cacheFile, mesh.mFilePath))
+    {
+        mesh.mIndexCount = static_cast<GLsizei>(mesh.mMeshFile.indexCount());
+        mesh.mLods.assign(mesh.mMeshFile.lods(), mesh.mMeshFile.lods() + mesh.mMeshFile.lodCount());
+        if (mesh.mLods.empty())
+            mesh.mLods.push_back(MeshLod{0, static_cast<GLuint>(mesh.mIndexCount), 0.f, 0});
+        mesh.mBounds = Bounds::fromVertices(mesh.mMeshFile.vertices(), mesh.mMeshFile.vertexCount());
+        qDebug() << "Mesh cache read: " << QString::fromStdString(filename) << "-"
+                 << mesh.mLods.front().indexCount / 3 << "triangles," << mesh.mMeshFile.vertexCount() << "vertices,"
+                 << mesh.mLods.size() << "levels of detail";
+        return;
+    }
+
+    //ObjReader maps the file and parses it in one pass, on several threads if the file is large
+    // - see objreader.h for what it supports
+    ObjReader::Statistics statistics;
+    if (!ObjReader::readFile(mesh.mFilePath, mesh.mMeshData, &statistics, mParseThreadCount))
+    {
+        qDebug() << "Could not read obj file: " << QString::fromStdString(filename);
+        return;
+    }
+
+    qDebug() << "Obj file read: " << QString::fromStdString(filename) << "-" << statistics.triangles << "triangles,"
+             << statistics.vertices << "vertices (" << statistics.faceCorners << "before welding )";
+
+    //Reorder for the vertex cache once here, the cache file keeps the new order
+    MeshOptimizer::Statistics optimizeStatistics;
+    MeshOptimizer::optimize(mesh.mMeshData, &optimizeStatistics);
+    qDebug() << "Mesh optimized: ACMR" << optimizeStatistics.acmrBefore << "->" << optimizeStatistics.acmrAfter
+             << "," << optimizeStatistics.clusters << "overdraw clusters";
+
+    //Simpler versions for drawing far away, after the full mesh in the same index buffer
+    MeshSimplifier::generateLods(mesh.mMeshData);
+    mesh.mLods = mesh.mMeshData.lods;
+    mesh.mBounds = Bounds::fromVertices(mesh.mMeshData.vertices.data(), mesh.mMeshData.vertices.size());
+    mesh.mIndexCount = static_cast<GLsizei>(mesh.mMeshData.indices.size());
+    for (std::size_t level = 1; level < mesh.mLods.size(); level++)
+        qDebug() << "  Level of detail" << level << ":" << mesh.mLods[level].indexCount / 3 << "triangles, error"
+                 << mesh.mLods[level].error;
+
+    //Make the cache for next time
+    QDir().mkpath(QFileInfo(QString::fromStdString(cacheFile)).absolutePath());
+    if (!MeshFile::write(cacheFile, mesh.mFilePath, mesh.mMeshData.vertices.data(), mesh.mMeshData.vertices.size(),
+                         mesh.mMeshData.indices.data(), mesh.mMeshData.indices.size(),
+                         mesh.mMeshData.lods.data(), mesh.mMeshData.lods.size()))
+        qDebug() << "Could not write mesh cache for " << QString::fromStdString(filename);
+}
+
+std::size_t MeshCache::upload(MeshResource *mesh)
+{
+    if (mesh->mUploaded)
+        return 0;
+
+    const Vertex *vertices = mesh->mMeshData.vertices.data();
+    std::size_t vertexCount = mesh->mMeshData.vertices.size();
+    const GLuint *indices = mesh->mMeshData.indices.data();
+    std::size_t indexCount = mesh->mMeshData.indices.size();
+    if (mesh->mMeshFile.isOpen())
+    {
+        vertices = mesh->mMeshFile.vertices();
+        vertexCount = mesh->mMeshFile.vertexCount();
+        indices = mesh->mMeshFile.indices();
+        indexCount = mesh->mMeshFile.indexCount();
+    }
+
+    //Vertex Array Object - VAO
+    glGenVertexArrays( 1, &mesh->mVAO );
+    glBindVertexArray( mesh->mVAO );
+
+    //Vertex Buffer Object to hold vertices - VBO
+    glGenBuffers( 1, &mesh->mVBO );
+    glBindBuffer( GL_ARRAY_BUFFER, mesh->mVBO );
+    mesh->mLayout = mVertexLayout;
+    if (mesh->mLayout == VertexLayout::Packed)
+    {
+        PackedMesh packed = vertexformat::pack(vertices, vertexCount);
+        glBufferData( GL_ARRAY_BUFFER, packed.mVertices.size()*sizeof(PackedVertex), packed.mVertices.data(), GL_STATIC_DRAW );
+        mesh->mPositionTransform = packed.mPositionTransform;
+    }
+    else
+    {
+        glBufferData( GL_ARRAY_BUFFER, vertexCount*sizeof(Vertex), vertices, GL_STATIC_DRAW );
+        mesh->mPositionTransform.setToIdentity();
+    }
+    vertexformat::setVertexAttributes(*this, mesh->mLayout);
+
+    //Second buffer - holds the indices (Element Array Buffer - EAB):
+    glGenBuffers(1, &mesh->mEAB);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->mEAB);
+    mesh->mIndexType = vertexformat::uploadIndices(*this, indices, indexCount, vertexCount);
+
+    glBindVertexArray(0);
+
+    std::size_t vertexSize = mesh->mLayout == VertexLayout::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+    std::size_t indexSize = mesh->mIndexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    mesh->mGpuBytes = vertexCount * vertexSize + indexCount * indexSize;
+
+    //The data is on the GPU now. A kept copy from the mapped cache is copied out, so the file can be closed.
+    if (mesh->mResidency == Residency::KeepCpuCopy)
+    {
+        if (mesh->mMeshFile.isOpen())
+        {
+            mesh->mMeshData.vertices.assign(vertices, vertices + vertexCount);
+            mesh->mMeshData.indices.assign(indices, indices + indexCount);
+            mesh->mMeshData.lods = mesh->mLods;
+        }
+    }
+    else
+    {
+        mesh->mMeshData = MeshData();
+    }
+    mesh->mMeshFile.close();
+    mesh->mUploaded = true;
+    return mesh->mGpuBytes;
+}
+
+void MeshCache::release(MeshResource *mesh)
+{
+    if (!mesh || --mesh->mReferenceCount > 0)
+        return;
+
+    //The loader thread still has it - update() deletes it when it comes back
+    if (mesh->mLoading)
+        return;
+    destroy(mesh);
+}
+
+void MeshCache::destroy(MeshResource *mesh)
+{
+    glDeleteVertexArrays(1, &mesh->mVAO);
+    glDeleteBuffers(1, &mesh->mVBO);
+    glDeleteBuffers(1, &mesh->mEAB);
+    std::string key = mesh->mFilePath;  //erase deletes mesh, so don't pass its own string
+    mMeshes.erase(key);
+}
+
+const MeshData *MeshCache::cpuData(MeshResource *mesh)
+{
+    if (!mesh || !mesh->mUploaded || mesh->mResidency == Residency::DropAfterUpload)
+        return nullptr;
+    if (!mesh->mMeshData.indices.empty() || mesh->mIndexCount == 0)
+        return &mesh->mMeshData;
+
+    //The .mesh cache has exactly what was uploaded: the optimized order and the levels of detail
+    MeshFile meshFile;
+    if (!meshFile.open(cacheFilePath(*mesh), mesh->mFilePath) ||
+            meshFile.indexCount() != static_cast<std::size_t>(mesh->mIndexCount))
+    {
+        qDebug() << "Could not reload mesh " << QString::fromStdString(mesh->mFileName) << "from its cache";
+        return nullptr;
+    }
+    mesh->mMeshData.vertices.assign(meshFile.vertices(), meshFile.vertices() + meshFile.vertexCount());
+    mesh->mMeshData.indices.assign(meshFile.indices(), meshFile.indices() + meshFile.indexCount());
+    mesh->mMeshData.lods = mesh->mLods;
+    return &mesh->mMeshData;
+}
+
+void MeshCache::releaseCpuData(MeshResource *mesh)
+{
+    if (mesh && mesh->mUploaded && mesh->mResidency != Residency::KeepCpuCopy)
+        mesh->mMeshData = MeshData();
+}
+
+MeshMemoryReport MeshCache::memoryReport() const
+{
+    MeshMemoryReport report;
+    for (const auto &entry : mMeshes)
+    {
+        const MeshResource &mesh = *entry.second;
+        report.meshes++;
+        //The loader thread may be filling in the data
+        if (mesh.mLoading)
+            continue;
+
+        report.gpuBytes += mesh.mGpuBytes;
+        std::size_t cpuBytes = mesh.mMeshData.vertices.capacity() * sizeof(Vertex) +
+                mesh.mMeshData.indices.capacity() * sizeof(GLuint) + mesh.mMeshData.lods.capacity() * sizeof(MeshLod);
+        report.cpuBytes += cpuBytes;
+        if (mesh.mUploaded && cpuBytes > 0)
+            report.meshesWithCpuCopy++;
+        if (mesh.mMeshFile.isOpen())
+            report.mappedBytes += mesh.mMeshFile.vertexCount() * sizeof(Vertex) + mesh.mMeshFile.indexCount() * sizeof(GLuint);
+    }
+    return report;
+}
+
+void MeshCache::logMemoryReport() const
+{
+    MeshMemoryReport report = memoryReport();
+    qDebug() << "Mesh memory:" << report.meshes << "meshes," << report.gpuBytes / 1024 << "KiB on the GPU,"
+             << report.cpuBytes / 1024 << "KiB on the CPU (" << report.meshesWithCpuCopy << "meshes with a CPU copy ),"
+             << report.mappedBytes / 1024 << "KiB mapped";
+}
+
+std::string MeshCache::cacheFilePath(const MeshResource &mesh) const
+{
+    return gsl::meshCacheFilePath + mesh.mFileName + ".mesh";
+}
+
+const MeshLod &MeshCache::selectLod(const MeshResource &mesh, const Bounds &worldBounds, const Camera &camera) const
+{
+    if (mesh.mLods.size() == 1 || worldBounds.isEmpty())
+        return mesh.mLods.front();
+
+    //The sphere grows with the largest scale of the model matrix, and so does the error
+    float scale = mesh.mBounds.mRadius > 0.f ? worldBounds.mRadius / mesh.mBounds.mRadius : 1.f;
+
+    float distance = (worldBounds.mCenter - camera.position()).length() - worldBounds.mRadius;
+    if (distance <= 0.f)
+        return mesh.mLods.front();
+
+    //(1, 1) of a perspective matrix is 1 / tan(fov / 2), so this is the size of one
+    //world unit at that distance as a part of the screen height
+    float unitOnScreen = camera.mProjectionMatrix(1, 1) * scale / (2.f * distance);
+    for (std::size_t level = mesh.mLods.size() - 1; level > 0; level--)
+    {
+        if (mesh.mLods[level].error * unitOnScreen <= mLodThreshold)
+            return mesh.mLods[level];
+    }
+    return mesh.mLods.front();
+}
@@ -0,0 +1,163 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <QOpenGLFunctions_4_1_Core>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "meshdata.h"
+#include "meshfile.h"
+#include "vertexformat.h"
+#include "bounds.h"
+
+class Camera;
+
+/**
+ * One mesh on the GPU, shared by all the objects that draw it.
+ * Owned by MeshCache - objects only hold a pointer between acquire() and release().
+ *
+ * While mLoading is true the loader thread fills in mIndexCount, mLods, mBounds, mMeshFile
+ * and mMeshData, so only look at mUploaded until the mesh is drawn.
+ */
+struct MeshResource
+{
+    std::string mFilePath;          //full path to the source file, the key in MeshCache
+    std::string mFileName;          //as given to acquire()
+
+    GLuint mVAO{0};
+    GLuint mVBO{0};
+    GLuint mEAB{0};                 //holds the indices (Element Array Buffer - EAB)
+    GLsizei mIndexCount{0};                 //all the levels of detail together
+    GLenum mIndexType{GL_UNSIGNED_INT};     //GL_UNSIGNED_SHORT if the mesh has few enough vertices
+
+    VertexLayout mLayout{VertexLayout::Float};
+    gsl::Matrix4x4 mPositionTransform;      //identity, except for VertexLayout::Packed - see PackedVertex
+
+    std::vector<MeshLod> mLods;             //level 0 is the full mesh, always at least one
+    Bounds mBounds;                         //in mesh space, made when the mesh is read
+
+    int mReferenceCount{0};
+    Residency mResidency{Residency::DropAfterUpload};
+    bool mLoading{false};           //queued for or being read on the loader thread
+    bool mUploaded{false};          //ready to draw
+    std::size_t mGpuBytes{0};       //vertex and index buffers
+
+    //Data waiting to be uploaded: either the mapped binary cache or a parsed mesh.
+    //After upload mMeshData is the CPU copy, if mResidency keeps one.
+    MeshFile mMeshFile;
+    MeshData mMeshData;
+};
+
+//Memory used by the meshes in a MeshCache
+struct MeshMemoryReport
+{
+    std::size_t meshes{0};
+    std::size_t gpuBytes{0};
+    std::size_t cpuBytes{0};            //CPU copies, and parsed meshes waiting for upload
+    std::size_t mappedBytes{0};         //.mesh files mapped and waiting for upload
+    std::size_t meshesWithCpuCopy{0};
+};
+
+/**
+ * Loads each mesh file once and keeps one set of GPU buffers for it,
+ * no matter how many objects use it. Reference counted: the buffers are deleted
+ * when the last object releases the mesh.
+ *
+ * Files are read on a loader thread, so acquire() returns at once and the frame loop never waits
+ * for parsing. update() makes the GPU buffers for the meshes that are done, a few per frame,
+ * and objects start drawing their mesh when MeshResource::mUploaded is set.
+ *
+ * Made and used on the render thread, while the OpenGL context is current.
+ */
+class MeshCache : protected QOpenGLFunctions_4_1_Core
+{
+public:
+    MeshCache();
+    ~MeshCache();
+    MeshCache(const MeshCache&) = delete;
+    MeshCache &operator=(const MeshCache&) = delete;
+
+    /**
+     * Get a mesh from the Meshes folder. If this is the first user, the file is queued for the loader thread,
+     * which uses the binary .mesh cache when it is up to date, else parses the obj file and writes the cache.
+     * If the file can't be read the mesh is empty (0 indices), so it draws nothing.
+     * @param filename File name inside gsl::assetFilePath + "Meshes/"
+     * @param residency What to do with the CPU copy after upload. If users of the same mesh
+     * ask for different ones, the one keeping the most wins.
+     */
+    MeshResource *acquire(const std::string &filename, Residency residency = Residency::DropAfterUpload);
+
+    //Call once a frame: makes the buffers for loaded meshes, until the upload budget is used up
+    void update();
+
+    //True while some meshes are still being read or waiting for upload
+    bool isLoading() const { return mLoadsInFlight > 0; }
+
+    //Bytes of vertex and index data update() may upload in one frame. At least one mesh is uploaded each frame.
+    void setUploadBudget(std::size_t bytesPerFrame) { mUploadBudget = bytesPerFrame; }
+
+    //Done with the mesh. The buffers are deleted when the last user releases it.
+    void release(MeshResource *mesh);
+
+    /**
+     * The vertices and indices of an uploaded mesh, on the CPU.
+     * KeepCpuCopy meshes have them already, ReloadOnDemand meshes read them back from the .mesh cache here.
+     * @return nullptr for DropAfterUpload meshes, meshes not uploaded yet, or if the reload fails
+     */
+    const MeshData *cpuData(MeshResource *mesh);
+
+    //Free a reloaded CPU copy again. KeepCpuCopy meshes keep theirs.
+    void releaseCpuData(MeshResource *mesh);
+
+    MeshMemoryReport memoryReport() const;
+    void logMemoryReport() const;
+
+    /**
+     * The simplest level of detail that still looks like the full mesh from where camera is:
+     * its error, projected with the camera's projection matrix, must be below the LOD threshold.
+     * @param worldBounds The bounds of the mesh where it is drawn (VisualObject::worldBounds())
+     */
+    const MeshLod &selectLod(const MeshResource &mesh, const Bounds &worldBounds, const Camera &camera) const;
+
+    //Largest error allowed on screen, as a part of the screen height. The default is about a pixel at 1080p.
+    void setLodThreshold(float threshold) { mLodThreshold = threshold; }
+
+    std::size_t meshCount() const { return mMeshes.size(); }
+
+    //Threads used to parse large obj files, 0 (the default) for one per processor core
+    void setParseThreadCount(unsigned threadCount) { mParseThreadCount = threadCount; }
+
+    //Vertex format for meshes uploaded from now on. Packed halves the size of the vertex buffers.
+    void setVertexLayout(VertexLayout layout) { mVertexLayout = layout; }
+
+private:
+    void read(MeshResource &mesh);
+    std::string cacheFilePath(const MeshResource &mesh) const;
+    void loaderLoop();
+
+    //Makes the VAO and buffers, and returns the bytes uploaded
+    std::size_t upload(MeshResource *mesh);
+    void destroy(MeshResource *mesh);
+
+    unsigned mParseThreadCount{0};
+    VertexLayout mVertexLayout{VertexLayout::Float};
+    float mLodThreshold{1.f / 1080.f};
+    std::size_t mUploadBudget{8 * 1024 * 1024};
+
+    //Loader thread. mLoadQueue and mLoaded are shared with it, under mMutex.
+    std::thread mLoader;
+    std::mutex mMutex;
+    std::condition_variable mWakeLoader;
+    std::deque<MeshResource*> mLoadQueue;
+    std::deque<MeshResource*> mLoaded;
+    bool mStopLoader{false};
+    std::size_t mLoadsInFlight{0};      //only used on the render thread
+
+    std::unordered_map<std::string, std::unique_ptr<MeshResource>> mMeshes;
+};
+
+#endif // MESHCACHE_H
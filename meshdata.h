@@ -0,0 +1,44 @@
+#ifndef MESHDATA_H
+#define MESHDATA_H
+
+#include <vector>
+#include "vertex.h"
+#include "gltypes.h"
+
+//What happens to the CPU copy of a mesh after its buffers are made on the GPU.
+//Ordered from keeping the least to the most.
+enum class Residency
+{
+    DropAfterUpload,    //freed, the mesh only exists on the GPU
+    ReloadOnDemand,     //freed, but read back from the .mesh cache when asked for
+    KeepCpuCopy         //kept, ex. for picking or physics on the triangles
+};
+
+//One level of detail: a range of the index array, drawn instead of the whole mesh.
+//All the levels index the same vertices.
+struct MeshLod
+{
+    GLuint indexOffset{0};
+    GLuint indexCount{0};
+    GLfloat error{0.f};     //how far the surface is from the full mesh, in mesh units
+    GLuint padding{0};      //keeps the size at 16 bytes in the .mesh file
+};
+static_assert(sizeof(MeshLod) == 16, "MeshLod is written to .mesh files as it is");
+
+//Mesh data on the CPU side, as read from a file - ready to be uploaded
+//to a vertex buffer (VBO) and an element array buffer (EAB)
+struct MeshData
+{
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> indices;
+    std::vector<MeshLod> lods;      //empty if the mesh has no levels of detail - then draw all indices
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+        lods.clear();
+    }
+};
+
+#endif // MESHDATA_H
@@ -0,0 +1,190 @@
+#include "innpch.h"
+#include "meshfile.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <cstring>
+
+namespace
+{
+    constexpr char Magic[4] = {'G', 'S', 'L', 'M'};
+}
+
+MeshFile::~MeshFile()
+{
+    close();
+}
+
+bool MeshFile::open(const std::string &cachePath, const std::string &sourcePath)
+{
+    close();
+
+    mFile.setFileName(QString::fromStdString(cachePath));
+    if (!mFile.open(QIODevice::ReadOnly))
+        return false;
+
+    qint64 size = mFile.size();
+    if (size < static_cast<qint64>(sizeof(Header)))
+    {
+        close();
+        return false;
+    }
+    mData = mFile.map(0, size);
+    if (!mData)
+    {
+        close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, mData, sizeof(Header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+            header.vertexSize != sizeof(Vertex) || header.indexSize != sizeof(GLuint))
+    {
+        close();
+        return false;
+    }
+
+    //The arrays must fill the rest of the file exactly. Checked by dividing, so huge counts can't overflow.
+    std::uint64_t dataSize = static_cast<std::uint64_t>(size) - sizeof(Header);
+    bool sizeOk = header.lodCount <= dataSize / sizeof(MeshLod);
+    if (sizeOk)
+    {
+        dataSize -= header.lodCount * sizeof(MeshLod);
+        sizeOk = header.vertexCount <= dataSize / sizeof(Vertex);
+    }
+    if (sizeOk)
+    {
+        std::uint64_t indexBytes = dataSize - header.vertexCount * sizeof(Vertex);
+        sizeOk = indexBytes % sizeof(GLuint) == 0 && header.indexCount == indexBytes / sizeof(GLuint);
+    }
+    if (!sizeOk)
+    {
+        qDebug() << "Mesh cache" << QString::fromStdString(cachePath) << "has the wrong size";
+        close();
+        return false;
+    }
+
+    QFileInfo source(QString::fromStdString(sourcePath));
+    if (source.exists())
+    {
+        if (static_cast<std::uint64_t>(source.size()) != header.sourceSize)
+        {
+            close();
+            return false;
+        }
+        //A new modification time with the same contents happens ex. after a checkout,
+        //so look at the contents before throwing the cache away
+        if (source.lastModified().toMSecsSinceEpoch() != header.sourceModified)
+        {
+            bool ok;
+            if (hashFile(sourcePath, ok) != header.sourceHash || !ok)
+            {
+                close();
+                return false;
+            }
+        }
+    }
+
+    mVertexCount = static_cast<std::size_t>(header.vertexCount);
+    mIndexCount = static_cast<std::size_t>(header.indexCount);
+    mLodCount = static_cast<std::size_t>(header.lodCount);
+    mVertices = reinterpret_cast<const Vertex*>(mData + sizeof(Header));
+    mIndices = reinterpret_cast<const GLuint*>(mData + sizeof(Header) + mVertexCount * sizeof(Vertex));
+    mLods = reinterpret_cast<const MeshLod*>(mIndices + mIndexCount);
+
+    for (std::size_t i = 0; i < mLodCount; i++)
+    {
+        if (mLods[i].indexOffset > mIndexCount || mLods[i].indexCount > mIndexCount - mLods[i].indexOffset)
+        {
+            qDebug() << "Mesh cache" << QString::fromStdString(cachePath) << "has a level of detail outside the indices";
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshFile::close()
+{
+    if (mData)
+        mFile.unmap(mData);
+    mFile.close();
+    mData = nullptr;
+    mVertices = nullptr;
+    mIndices = nullptr;
+    mLods = nullptr;
+    mVertexCount = 0;
+    mIndexCount = 0;
+    mLodCount = 0;
+}
+
+bool MeshFile::write(const std::string &cachePath, const std::string &sourcePath,
+                     const Vertex *vertices, std::size_t vertexCount,
+                     const GLuint *indices, std::size_t indexCount,
+                     const MeshLod *lods, std::size_t lodCount)
+{
+    bool ok;
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.vertexSize = sizeof(Vertex);
+    header.indexSize = sizeof(GLuint);
+    header.sourceHash = hashFile(sourcePath, ok);
+    if (!ok)
+        return false;
+    QFileInfo source(QString::fromStdString(sourcePath));
+    header.sourceSize = static_cast<std::uint64_t>(source.size());
+    header.sourceModified = source.lastModified().toMSecsSinceEpoch();
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    header.lodCount = lodCount;
+
+    QSaveFile file(QString::fromStdString(cachePath));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Could not write mesh cache: " << QString::fromStdString(cachePath);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(vertices), static_cast<qint64>(vertexCount * sizeof(Vertex)));
+    file.write(reinterpret_cast<const char*>(indices), static_cast<qint64>(indexCount * sizeof(GLuint)));
+    if (lodCount > 0)
+        file.write(reinterpret_cast<const char*>(lods), static_cast<qint64>(lodCount * sizeof(MeshLod)));
+    return file.commit();
+}
+
+std::uint64_t MeshFile::hashFile(const std::string &filePath, bool &ok)
+{
+    ok = false;
+    QFile file(QString::fromStdString(filePath));
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const uchar *data, std::size_t size) {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    qint64 size = file.size();
+    if (size > 0)
+    {
+        const uchar *data = file.map(0, size);
+        if (data)
+        {
+            add(data, static_cast<std::size_t>(size));
+        }
+        else
+        {
+            QByteArray bytes = file.readAll();
+            add(reinterpret_cast<const uchar*>(bytes.constData()), static_cast<std::size_t>(bytes.size()));
+        }
+    }
+    ok = true;
+    return hash;
+}
@@ -0,0 +1,93 @@
+#ifndef MESHFILE_H
+#define MESHFILE_H
+
+#include <QFile>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "meshdata.h"
+#include "gltypes.h"
+
+/**
+ * Binary mesh cache (.mesh files), written after a source file (ex. an .obj) is parsed
+ * the first time, so later loads skip the text parsing.
+ *
+ * The file is a Header followed by the raw Vertex array, the raw GLuint index array
+ * and the MeshLod array (levels of detail, ranges of the index array), in the byte order and layout of the machine that wrote it. It is only a cache:
+ * if the version, layout or source file doesn't match, open() fails and the caller
+ * parses the source again and writes a new cache.
+ *
+ * open() memory maps the file, and vertices()/indices() point straight into the mapping,
+ * so they can be given to glBufferData without copying. They are valid until close().
+ */
+class MeshFile
+{
+public:
+    //Increase when the header, Vertex or what is done to the mesh before writing changes,
+    //so old caches are thrown away. 2: meshes are run through MeshOptimizer. 3: levels of detail.
+    static constexpr std::uint32_t Version = 3;
+
+    MeshFile() = default;
+    ~MeshFile();
+    MeshFile(const MeshFile&) = delete;
+    MeshFile &operator=(const MeshFile&) = delete;
+
+    /**
+     * Map a cache file
+     * @param cachePath Full path to the .mesh file
+     * @param sourcePath The file the cache was made from. The cache is used if the source has
+     * the same size and modification time as when the cache was written, or the same contents.
+     * If the source file is missing, the cache is used as it is.
+     * @return false if there is no valid cache for the source
+     */
+    bool open(const std::string &cachePath, const std::string &sourcePath);
+    void close();
+    bool isOpen() const { return mData != nullptr; }
+
+    const Vertex *vertices() const { return mVertices; }
+    std::size_t vertexCount() const { return mVertexCount; }
+    const GLuint *indices() const { return mIndices; }
+    std::size_t indexCount() const { return mIndexCount; }
+    const MeshLod *lods() const { return mLods; }
+    std::size_t lodCount() const { return mLodCount; }
+
+    /**
+     * Write a cache file for the mesh made from sourcePath.
+     * The file is written to a temporary name and renamed when done,
+     * so a crash never leaves a half written cache.
+     */
+    static bool write(const std::string &cachePath, const std::string &sourcePath,
+                      const Vertex *vertices, std::size_t vertexCount,
+                      const GLuint *indices, std::size_t indexCount,
+                      const MeshLod *lods = nullptr, std::size_t lodCount = 0);
+
+    //64 bit FNV-1a hash of a whole file. Sets ok to false if the file can't be read.
+    static std::uint64_t hashFile(const std::string &filePath, bool &ok);
+
+private:
+    struct Header
+    {
+        char magic[4];                  //"GSLM"
+        std::uint32_t version;
+        std::uint32_t vertexSize;       //sizeof(Vertex) when written
+        std::uint32_t indexSize;        //sizeof(GLuint) when written
+        std::uint64_t sourceSize;
+        std::int64_t sourceModified;    //milliseconds since epoch
+        std::uint64_t sourceHash;
+        std::uint64_t vertexCount;
+        std::uint64_t indexCount;
+        std::uint64_t lodCount;
+    };
+    static_assert(sizeof(Header) == 64, "MeshFile::Header must be 64 bytes");
+
+    QFile mFile;
+    uchar *mData{nullptr};
+    const Vertex *mVertices{nullptr};
+    const GLuint *mIndices{nullptr};
+    const MeshLod *mLods{nullptr};
+    std::size_t mVertexCount{0};
+    std::size_t mIndexCount{0};
+    std::size_t mLodCount{0};
+};
+
+#endif // MESHFILE_H
@@ -0,0 +1,328 @@
+#include "innpch.h"
+#include "meshoptimizer.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+    constexpr GLuint None = std::numeric_limits<GLuint>::max();
+
+    //FIFO vertex cache simulated with time stamps: the time only moves on a miss,
+    //so a vertex is still cached if fewer than cacheSize misses happened since it was loaded
+    class FifoCache
+    {
+    public:
+        FifoCache(std::size_t vertexCount, unsigned cacheSize)
+            : mStamps(vertexCount, 0), mCacheSize{cacheSize}, mTime{cacheSize + std::size_t{1}}
+        { }
+
+        //Returns true on a miss
+        bool access(GLuint vertex)
+        {
+            if (mTime - mStamps[vertex] > mCacheSize)
+            {
+                mStamps[vertex] = mTime++;
+                return true;
+            }
+            return false;
+        }
+
+        //Misses since the vertex was loaded
+        std::size_t age(GLuint vertex) const { return mTime - mStamps[vertex]; }
+
+        void flush() { mTime += mCacheSize + 1; }
+
+    private:
+        std::vector<std::size_t> mStamps;
+        std::size_t mCacheSize;
+        std::size_t mTime;
+    };
+
+    //Triangles using each vertex, as one array with an offset per vertex
+    struct Adjacency
+    {
+        std::vector<std::size_t> offsets;   //vertexCount + 1
+        std::vector<std::size_t> triangles;
+
+        Adjacency(const std::vector<GLuint> &indices, std::size_t vertexCount)
+            : offsets(vertexCount + 1, 0), triangles(indices.size())
+        {
+            for (GLuint index : indices)
+                offsets[index + 1]++;
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < indices.size(); i++)
+                triangles[fill[indices[i]]++] = i / 3;
+        }
+    };
+
+    std::size_t clusterEnd(const std::vector<std::size_t> &clusters, std::size_t cluster, std::size_t triangleCount)
+    {
+        return cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangleCount;
+    }
+}
+
+void MeshOptimizer::optimize(MeshData &mesh, Statistics *statistics, float overdrawThreshold, unsigned cacheSize)
+{
+    std::size_t vertexCount = mesh.vertices.size();
+    if (mesh.indices.size() % 3 != 0 ||
+            std::any_of(mesh.indices.begin(), mesh.indices.end(), [=](GLuint index) { return index >= vertexCount; }))
+    {
+        qDebug() << "MeshOptimizer: the indices are not a valid triangle list, not optimized";
+        return;
+    }
+
+    if (statistics)
+        *statistics = Statistics{acmr(mesh.indices.data(), mesh.indices.size(), vertexCount, cacheSize), 0.f, 0};
+
+    std::vector<std::size_t> clusters;
+    optimizeVertexCache(mesh.indices, vertexCount, cacheSize, overdrawThreshold > 0.f ? &clusters : nullptr);
+    if (overdrawThreshold > 0.f)
+    {
+        optimizeOverdraw(mesh.indices, mesh.vertices, clusters, overdrawThreshold, cacheSize);
+        if (statistics)
+            statistics->clusters = clusters.size();
+    }
+    optimizeVertexFetch(mesh);
+
+    if (statistics)
+        statistics->acmrAfter = acmr(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size(), cacheSize);
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<GLuint> &indices, std::size_t vertexCount, unsigned cacheSize,
+                                        std::vector<std::size_t> *clusters)
+{
+    if (clusters)
+        clusters->clear();
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    Adjacency adjacency(indices, vertexCount);
+
+    //Triangles not drawn yet, per vertex
+    std::vector<std::size_t> liveTriangles(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; v++)
+        liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<GLuint> deadEnds;       //recently used vertices, to go back to when stuck
+    deadEnds.reserve(indices.size());
+    std::vector<GLuint> candidates;
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::size_t nextVertex = 0;         //where to look for unfinished vertices when there are no dead ends left
+
+    //Fans around one vertex at a time: draw all its triangles, then move to the neighbour that
+    //will still be in the cache after its own triangles are drawn, preferring the oldest.
+    GLuint fanning = 0;
+    while (liveTriangles[fanning] == 0)
+        fanning++;
+    if (clusters)
+        clusters->push_back(0);
+
+    for (;;)
+    {
+        candidates.clear();
+        for (std::size_t a = adjacency.offsets[fanning]; a < adjacency.offsets[fanning + 1]; a++)
+        {
+            std::size_t triangle = adjacency.triangles[a];
+            if (emitted[triangle])
+                continue;
+            for (std::size_t corner = 0; corner < 3; corner++)
+            {
+                GLuint vertex = indices[triangle * 3 + corner];
+                result.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                cache.access(vertex);
+            }
+            emitted[triangle] = true;
+        }
+
+        GLuint best = None;
+        std::size_t bestPriority = 0;
+        for (GLuint vertex : candidates)
+        {
+            if (liveTriangles[vertex] == 0)
+                continue;
+            //Only a vertex whose fan fits in the cache gets a priority, older is better
+            std::size_t priority = 1;
+            if (cache.age(vertex) + 2 * liveTriangles[vertex] <= cacheSize)
+                priority += cache.age(vertex);
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                best = vertex;
+            }
+        }
+
+        if (best == None)
+        {
+            //Dead end: go back to a recent vertex, else to the next unfinished one in the mesh
+            while (!deadEnds.empty() && best == None)
+            {
+                GLuint vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveTriangles[vertex] > 0)
+                    best = vertex;
+            }
+            while (best == None && nextVertex < vertexCount)
+            {
+                if (liveTriangles[nextVertex] > 0)
+                    best = static_cast<GLuint>(nextVertex);
+                nextVertex++;
+            }
+            if (best == None)
+                break;
+            if (clusters)
+                clusters->push_back(result.size() / 3);
+        }
+        fanning = best;
+    }
+
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<GLuint> &indices, const std::vector<Vertex> &vertices,
+                                     std::vector<std::size_t> &clusters, float threshold, unsigned cacheSize)
+{
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+    if (clusters.empty())
+        clusters.push_back(0);
+
+    //Split each cluster where the cache misses so far are close enough to those of the whole cluster.
+    //The cache starts over at every cluster, since any cluster can be drawn after any other.
+    FifoCache cache(vertices.size(), cacheSize);
+    std::vector<std::size_t> softClusters;
+    for (std::size_t c = 0; c < clusters.size(); c++)
+    {
+        std::size_t begin = clusters[c];
+        std::size_t end = clusterEnd(clusters, c, triangleCount);
+
+        cache.flush();
+        std::size_t clusterMisses = 0;
+        for (std::size_t i = begin * 3; i < end * 3; i++)
+            clusterMisses += cache.access(indices[i]);
+        float limit = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        cache.flush();
+        softClusters.push_back(begin);
+        std::size_t misses = 0;
+        std::size_t start = begin;
+        for (std::size_t triangle = begin; triangle < end; triangle++)
+        {
+            for (std::size_t corner = 0; corner < 3; corner++)
+                misses += cache.access(indices[triangle * 3 + corner]);
+
+            std::size_t drawn = triangle + 1 - start;
+            if (triangle + 1 < end && static_cast<float>(misses) <= limit * static_cast<float>(drawn))
+            {
+                softClusters.push_back(triangle + 1);
+                start = triangle + 1;
+                misses = 0;
+                cache.flush();
+            }
+        }
+    }
+
+    //Area weighted middle and normal of each cluster, and the middle of the whole mesh
+    struct Cluster
+    {
+        std::size_t begin;
+        std::size_t end;
+        float sortKey;
+    };
+    std::vector<Cluster> sorted;
+    sorted.reserve(softClusters.size());
+
+    std::vector<gsl::Vector3D> centers(softClusters.size());
+    std::vector<gsl::Vector3D> normals(softClusters.size());
+    gsl::Vector3D meshCenter;
+    float meshArea = 0.f;
+    for (std::size_t c = 0; c < softClusters.size(); c++)
+    {
+        std::size_t begin = softClusters[c];
+        std::size_t end = clusterEnd(softClusters, c, triangleCount);
+
+        gsl::Vector3D center;
+        gsl::Vector3D normal;
+        float area = 0.f;
+        for (std::size_t triangle = begin; triangle < end; triangle++)
+        {
+            const gsl::Vector3D &p0 = vertices[indices[triangle * 3]].xyz();
+            const gsl::Vector3D &p1 = vertices[indices[triangle * 3 + 1]].xyz();
+            const gsl::Vector3D &p2 = vertices[indices[triangle * 3 + 2]].xyz();
+            gsl::Vector3D cross = (p1 - p0) ^ (p2 - p0);    //length is twice the area
+            float triangleArea = cross.length();
+            center += (p0 + p1 + p2) * (triangleArea / 3.f);
+            normal += cross;
+            area += triangleArea;
+        }
+        meshCenter += center;
+        meshArea += area;
+        centers[c] = area > 0.f ? center * (1.f / area) : vertices[indices[begin * 3]].xyz();
+        normals[c] = normal;
+        sorted.push_back(Cluster{begin, end, 0.f});
+    }
+    if (meshArea > 0.f)
+        meshCenter = meshCenter * (1.f / meshArea);
+
+    //Clusters facing away from the middle are on the outside, and are drawn first
+    for (std::size_t c = 0; c < sorted.size(); c++)
+    {
+        float normalLength = normals[c].length();
+        sorted[c].sortKey = normalLength > 0.f ? gsl::Vector3D::dot(centers[c] - meshCenter, normals[c]) / normalLength
+                                               : 0.f;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Cluster &a, const Cluster &b) { return a.sortKey > b.sortKey; });
+
+    std::vector<GLuint> result;
+    result.reserve(indices.size());
+    clusters.clear();
+    for (const Cluster &cluster : sorted)
+    {
+        clusters.push_back(result.size() / 3);
+        result.insert(result.end(), indices.begin() + static_cast<std::ptrdiff_t>(cluster.begin * 3),
+                      indices.begin() + static_cast<std::ptrdiff_t>(cluster.end * 3));
+    }
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData &mesh)
+{
+    std::vector<GLuint> remap(mesh.vertices.size(), None);
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (GLuint &index : mesh.indices)
+    {
+        if (remap[index] == None)
+        {
+            remap[index] = static_cast<GLuint>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices.swap(vertices);
+}
+
+float MeshOptimizer::acmr(const GLuint *indices, std::size_t indexCount, std::size_t vertexCount, unsigned cacheSize)
+{
+    std::size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0)
+        return 0.f;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i < triangleCount * 3; i++)
+        misses += cache.access(indices[i]);
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
@@ -0,0 +1,386 @@
+#include "innpch.h"
+#include "meshsimplifier.h"
+#include "meshoptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+    //Border planes count this much more than the triangles around them
+    constexpr double BorderWeight{10.0};
+
+    //Cosine of the most a triangle may turn in one collapse
+    constexpr float MaxNormalChange{0.5f};
+
+    //Sum of squared distances to planes, as the symmetric matrix A, vector b and constant c
+    //of p'Ap + 2b'p + c. Weighted, so error() is a mean squared distance.
+    struct Quadric
+    {
+        double a00{0.0}, a01{0.0}, a02{0.0}, a11{0.0}, a12{0.0}, a22{0.0};
+        double b0{0.0}, b1{0.0}, b2{0.0};
+        double c{0.0};
+        double weight{0.0};
+
+        //Plane n.p + d = 0, with normal n of length 1
+        static Quadric fromPlane(const gsl::Vector3D &n, double d, double weight)
+        {
+            Quadric q;
+            q.a00 = weight * n.x * n.x;
+            q.a01 = weight * n.x * n.y;
+            q.a02 = weight * n.x * n.z;
+            q.a11 = weight * n.y * n.y;
+            q.a12 = weight * n.y * n.z;
+            q.a22 = weight * n.z * n.z;
+            q.b0 = weight * n.x * d;
+            q.b1 = weight * n.y * d;
+            q.b2 = weight * n.z * d;
+            q.c = weight * d * d;
+            q.weight = weight;
+            return q;
+        }
+
+        Quadric &operator+=(const Quadric &other)
+        {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02;
+            a11 += other.a11; a12 += other.a12; a22 += other.a22;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+            return *this;
+        }
+
+        double error(const gsl::Vector3D &p) const
+        {
+            if (weight <= 0.0)
+                return 0.0;
+            double x = p.x, y = p.y, z = p.z;
+            double sum = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                    2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return std::max(0.0, sum / weight);
+        }
+    };
+
+    struct PositionKey
+    {
+        std::uint32_t x, y, z;
+
+        bool operator==(const PositionKey &other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct PositionKeyHash
+    {
+        std::size_t operator()(const PositionKey &key) const
+        {
+            std::uint64_t hash = key.x;
+            hash = hash * 0x9E3779B97F4A7C15ull + key.y;
+            hash = hash * 0x9E3779B97F4A7C15ull + key.z;
+            return static_cast<std::size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+    struct Collapse
+    {
+        GLuint from;
+        GLuint to;
+        double error;   //squared distance
+    };
+
+    //Items grouped by a key, as one array with an offset per key
+    struct Groups
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<GLuint> items;
+
+        template <typename KeyOf>
+        void build(std::size_t keyCount, std::size_t itemCount, KeyOf keyOf)
+        {
+            offsets.assign(keyCount + 1, 0);
+            for (std::size_t i = 0; i < itemCount; i++)
+                offsets[keyOf(i) + 1]++;
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            items.resize(itemCount);
+            std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < itemCount; i++)
+                items[fill[keyOf(i)]++] = static_cast<GLuint>(i);
+        }
+
+        const GLuint *begin(std::size_t key) const { return items.data() + offsets[key]; }
+        const GLuint *end(std::size_t key) const { return items.data() + offsets[key + 1]; }
+    };
+
+    //The vertex at the new position whose normal and uv are closest to those of vertex
+    GLuint closestVertex(const std::vector<Vertex> &vertices, GLuint vertex, const GLuint *begin, const GLuint *end)
+    {
+        GLuint best = *begin;
+        float bestDistance = std::numeric_limits<float>::max();
+        for (const GLuint *candidate = begin; candidate != end; ++candidate)
+        {
+            gsl::Vector3D normal = vertices[*candidate].normal() - vertices[vertex].normal();
+            float du = vertices[*candidate].st().x - vertices[vertex].st().x;
+            float dv = vertices[*candidate].st().y - vertices[vertex].st().y;
+            float distance = gsl::Vector3D::dot(normal, normal) + du * du + dv * dv;
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                best = *candidate;
+            }
+        }
+        return best;
+    }
+}
+
+std::vector<GLuint> MeshSimplifier::simplify(const std::vector<Vertex> &vertices, const GLuint *indices,
+                                             std::size_t indexCount, std::size_t targetIndexCount,
+                                             float maxError, float *resultError)
+{
+    std::vector<GLuint> result(indices, indices + indexCount / 3 * 3);
+    if (resultError)
+        *resultError = 0.f;
+    if (result.size() <= targetIndexCount)
+        return result;
+
+    //Vertices with the same position are collapsed together
+    std::size_t vertexCount = vertices.size();
+    std::vector<GLuint> positionOf(vertexCount);
+    std::vector<gsl::Vector3D> positions;
+    {
+        std::unordered_map<PositionKey, GLuint, PositionKeyHash> positionIds;
+        positionIds.reserve(vertexCount);
+        for (std::size_t v = 0; v < vertexCount; v++)
+        {
+            const gsl::Vector3D &xyz = vertices[v].xyz();
+            PositionKey key;
+            std::memcpy(&key.x, &xyz.x, sizeof(key.x));
+            std::memcpy(&key.y, &xyz.y, sizeof(key.y));
+            std::memcpy(&key.z, &xyz.z, sizeof(key.z));
+            auto inserted = positionIds.emplace(key, static_cast<GLuint>(positions.size()));
+            if (inserted.second)
+                positions.push_back(xyz);
+            positionOf[v] = inserted.first->second;
+        }
+    }
+    std::size_t positionCount = positions.size();
+    Groups verticesAt;
+    verticesAt.build(positionCount, vertexCount, [&](std::size_t v) { return positionOf[v]; });
+
+    auto corner = [&](std::size_t triangle, std::size_t c) { return positionOf[result[triangle * 3 + c]]; };
+
+    //Quadrics from the planes of the triangles, and of the borders (edges with only one triangle)
+    std::vector<Quadric> quadrics(positionCount);
+    struct Edge
+    {
+        GLuint a, b;
+        std::size_t triangle;
+    };
+    std::vector<Edge> edges;
+    edges.reserve(result.size());
+    for (std::size_t triangle = 0; triangle < result.size() / 3; triangle++)
+    {
+        gsl::Vector3D cross = (positions[corner(triangle, 1)] - positions[corner(triangle, 0)]) ^
+                (positions[corner(triangle, 2)] - positions[corner(triangle, 0)]);
+        float length = cross.length();
+        if (length <= 0.f)
+            continue;
+        gsl::Vector3D normal = cross * (1.f / length);
+        Quadric plane = Quadric::fromPlane(normal, -gsl::Vector3D::dot(normal, positions[corner(triangle, 0)]),
+                                           0.5 * length);
+        for (std::size_t c = 0; c < 3; c++)
+        {
+            quadrics[corner(triangle, c)] += plane;
+            GLuint a = corner(triangle, c);
+            GLuint b = corner(triangle, (c + 1) % 3);
+            edges.push_back(Edge{std::min(a, b), std::max(a, b), triangle});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge &x, const Edge &y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+    for (std::size_t i = 0; i < edges.size(); )
+    {
+        std::size_t next = i + 1;
+        while (next < edges.size() && edges[next].a == edges[i].a && edges[next].b == edges[i].b)
+            next++;
+        if (next == i + 1)
+        {
+            //A border: plane through the edge, standing straight up from its triangle
+            const Edge &edge = edges[i];
+            gsl::Vector3D faceNormal = (positions[corner(edge.triangle, 1)] - positions[corner(edge.triangle, 0)]) ^
+                    (positions[corner(edge.triangle, 2)] - positions[corner(edge.triangle, 0)]);
+            gsl::Vector3D direction = positions[edge.b] - positions[edge.a];
+            gsl::Vector3D normal = direction ^ faceNormal;
+            float length = normal.length();
+            if (length > 0.f)
+            {
+                normal = normal * (1.f / length);
+                Quadric plane = Quadric::fromPlane(normal, -gsl::Vector3D::dot(normal, positions[edge.a]),
+                                                   BorderWeight * gsl::Vector3D::dot(direction, direction));
+                quadrics[edge.a] += plane;
+                quadrics[edge.b] += plane;
+            }
+        }
+        i = next;
+    }
+
+    double maxErrorSquared = static_cast<double>(maxError) * static_cast<double>(maxError);
+    double worstError = 0.0;
+    std::vector<GLuint> vertexRemap(vertexCount);
+    std::vector<bool> locked(positionCount);
+    std::vector<std::pair<GLuint, GLuint>> uniqueEdges;
+    std::vector<Collapse> collapses;
+    Groups trianglesAt;
+
+    //Each pass collapses the cheapest edges that don't touch each other, then removes the flat triangles
+    while (result.size() > targetIndexCount)
+    {
+        std::size_t triangleCount = result.size() / 3;
+        trianglesAt.build(positionCount, result.size(), [&](std::size_t i) { return positionOf[result[i]]; });
+
+        uniqueEdges.clear();
+        for (std::size_t triangle = 0; triangle < triangleCount; triangle++)
+        {
+            for (std::size_t c = 0; c < 3; c++)
+            {
+                GLuint a = corner(triangle, c);
+                GLuint b = corner(triangle, (c + 1) % 3);
+                uniqueEdges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+        std::sort(uniqueEdges.begin(), uniqueEdges.end());
+        uniqueEdges.erase(std::unique(uniqueEdges.begin(), uniqueEdges.end()), uniqueEdges.end());
+
+        //Collapse each edge in the direction with the smaller error
+        collapses.clear();
+        for (const auto &edge : uniqueEdges)
+        {
+            Quadric sum = quadrics[edge.first];
+            sum += quadrics[edge.second];
+            double toFirst = sum.error(positions[edge.first]);
+            double toSecond = sum.error(positions[edge.second]);
+            if (toSecond <= toFirst)
+                collapses.push_back(Collapse{edge.first, edge.second, toSecond});
+            else
+                collapses.push_back(Collapse{edge.second, edge.first, toFirst});
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse &x, const Collapse &y) {
+            if (x.error != y.error)
+                return x.error < y.error;
+            return x.from != y.from ? x.from < y.from : x.to < y.to;
+        });
+
+        std::iota(vertexRemap.begin(), vertexRemap.end(), 0);
+        std::fill(locked.begin(), locked.end(), false);
+        std::size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+        std::size_t removed = 0;
+        std::size_t collapsed = 0;
+        for (const Collapse &collapse : collapses)
+        {
+            if (collapse.error > maxErrorSquared || removed >= trianglesToRemove)
+                break;
+            if (locked[collapse.from] || locked[collapse.to])
+                continue;
+
+            //Triangles around from must not flip, or turn more than 60 degrees, when it moves to to.
+            //Those that have both ends of the edge are removed.
+            bool valid = true;
+            std::size_t collapseRemoves = 0;
+            for (const GLuint *i = trianglesAt.begin(collapse.from); i != trianglesAt.end(collapse.from) && valid; ++i)
+            {
+                std::size_t triangle = *i / 3;
+                GLuint p[3] = {corner(triangle, 0), corner(triangle, 1), corner(triangle, 2)};
+                if (p[0] == collapse.to || p[1] == collapse.to || p[2] == collapse.to)
+                {
+                    collapseRemoves++;
+                    continue;
+                }
+                gsl::Vector3D before = (positions[p[1]] - positions[p[0]]) ^ (positions[p[2]] - positions[p[0]]);
+                for (GLuint &position : p)
+                {
+                    if (position == collapse.from)
+                        position = collapse.to;
+                }
+                gsl::Vector3D after = (positions[p[1]] - positions[p[0]]) ^ (positions[p[2]] - positions[p[0]]);
+                valid = gsl::Vector3D::dot(before, after) > MaxNormalChange * before.length() * after.length();
+            }
+            if (!valid)
+                continue;
+
+            for (const GLuint *v = verticesAt.begin(collapse.from); v != verticesAt.end(collapse.from); ++v)
+                vertexRemap[*v] = closestVertex(vertices, *v, verticesAt.begin(collapse.to), verticesAt.end(collapse.to));
+            quadrics[collapse.to] += quadrics[collapse.from];
+
+            //The triangles around from change, so nothing in them may move again in this pass
+            for (const GLuint *i = trianglesAt.begin(collapse.from); i != trianglesAt.end(collapse.from); ++i)
+            {
+                std::size_t triangle = *i / 3;
+                for (std::size_t c = 0; c < 3; c++)
+                    locked[corner(triangle, c)] = true;
+            }
+            locked[collapse.to] = true;
+
+            removed += collapseRemoves;
+            collapsed++;
+            worstError = std::max(worstError, collapse.error);
+        }
+        if (collapsed == 0)
+            break;
+
+        std::size_t written = 0;
+        for (std::size_t triangle = 0; triangle < triangleCount; triangle++)
+        {
+            GLuint v0 = vertexRemap[result[triangle * 3]];
+            GLuint v1 = vertexRemap[result[triangle * 3 + 1]];
+            GLuint v2 = vertexRemap[result[triangle * 3 + 2]];
+            if (positionOf[v0] == positionOf[v1] || positionOf[v1] == positionOf[v2] || positionOf[v0] == positionOf[v2])
+                continue;
+            result[written++] = v0;
+            result[written++] = v1;
+            result[written++] = v2;
+        }
+        result.resize(written);
+    }
+
+    if (resultError)
+        *resultError = static_cast<float>(std::sqrt(worstError));
+    return result;
+}
+
+void MeshSimplifier::generateLods(MeshData &mesh, unsigned lodCount, float reduction)
+{
+    std::size_t fullCount = mesh.indices.size();
+    mesh.lods.assign(1, MeshLod{0, static_cast<GLuint>(fullCount), 0.f, 0});
+
+    //Every level is made from the full mesh, so the errors are measured against it
+    std::size_t previousCount = fullCount;
+    float previousError = 0.f;
+    double target = static_cast<double>(fullCount);
+    for (unsigned level = 1; level < lodCount; level++)
+    {
+        target *= static_cast<double>(reduction);
+        std::size_t targetCount = static_cast<std::size_t>(target) / 3 * 3;
+        if (targetCount < MinLodTriangles * 3)
+            break;
+
+        float error = 0.f;
+        std::vector<GLuint> lod = simplify(mesh.vertices, mesh.indices.data(), fullCount, targetCount,
+                                           std::numeric_limits<float>::max(), &error);
+        //Stop when it can't get much simpler, ex. when the borders hold it in place
+        if (lod.size() * 10 > previousCount * 9)
+            break;
+
+        MeshOptimizer::optimizeVertexCache(lod, mesh.vertices.size());
+        error = std::max(error, previousError);
+        mesh.lods.push_back(MeshLod{static_cast<GLuint>(mesh.indices.size()), static_cast<GLuint>(lod.size()), error, 0});
+        mesh.indices.insert(mesh.indices.end(), lod.begin(), lod.end());
+
+        previousCount = lod.size();
+        previousError = error;
+    }
+}
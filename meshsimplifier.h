@@ -0,0 +1,43 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <cstddef>
+#include <vector>
+#include "meshdata.h"
+
+/**
+ * Makes lower detail versions of a mesh with quadric error metrics (Garland and Heckbert 1997).
+ * Edges are collapsed onto one of their ends, so no vertices are made or moved:
+ * every level only has its own indices and shares the vertex buffer of the full mesh.
+ *
+ * Vertices with the same position (ex. at uv seams) move together, so the surface doesn't crack.
+ * Open borders get extra error, so they stay in place longer than the inside.
+ */
+class MeshSimplifier
+{
+public:
+    //Each level has about this part of the triangles of the level before
+    static constexpr float DefaultReduction{0.5f};
+
+    //Levels stop when they would have fewer triangles than this
+    static constexpr std::size_t MinLodTriangles{64};
+
+    /**
+     * Simplify the triangles given by indices
+     * @param targetIndexCount Stop when this few indices are left
+     * @param maxError Don't make collapses with a larger error, as a distance in mesh units
+     * @param resultError Optional, gets the largest error of the collapses made
+     * @return The new indices, into the same vertices
+     */
+    static std::vector<GLuint> simplify(const std::vector<Vertex> &vertices, const GLuint *indices,
+                                        std::size_t indexCount, std::size_t targetIndexCount,
+                                        float maxError, float *resultError = nullptr);
+
+    /**
+     * Adds up to lodCount - 1 simpler levels after the indices of mesh, each sorted for the vertex cache,
+     * and fills in mesh.lods. Level 0 is the mesh as it was.
+     */
+    static void generateLods(MeshData &mesh, unsigned lodCount = 4, float reduction = DefaultReduction);
+};
+
+#endif // MESHSIMPLIFIER_H
@@ -1,19 +1,25 @@
 #include "innpch.h"
 #include "objmesh.h"
+#include "meshcache.h"
+#include "camera.h"
 
 ObjMesh::ObjMesh() : VisualObject ()
 {
 
 }
 
-ObjMesh::ObjMesh(std::string filename) : VisualObject ()
+ObjMesh::ObjMesh(const std::string &filename, MeshCache *meshCache, Residency residency)
+    : VisualObject (), mMeshCache{meshCache}
 {
-    readFile(filename);
+    mResidency = residency;
+    mMesh = mMeshCache->acquire(filename, residency);
     mMatrix.setToIdentity();
 }
 
 ObjMesh::~ObjMesh()
 {
+    if (mMeshCache)
+        mMeshCache->release(mMesh);
 }
 
 void ObjMesh::init()
@@ -21,190 +27,36 @@ void ObjMesh::init()
     //must call this to use OpenGL functions
     initializeOpenGLFunctions();
 
-    //Vertex Array Object - VAO
-    glGenVertexArrays( 1, &mVAO );
-    glBindVertexArray( mVAO );
-
-    //Vertex Buffer Object to hold vertices - VBO
-    glGenBuffers( 1, &mVBO );
-    glBindBuffer( GL_ARRAY_BUFFER, mVBO );
-
-    glBufferData( GL_ARRAY_BUFFER, mVertices.size()*sizeof(Vertex), mVertices.data(), GL_STATIC_DRAW );
-
-    // 1rst attribute buffer : vertices
-    glVertexAttribPointer(0, 3, GL_FLOAT,GL_FALSE, sizeof(Vertex), (GLvoid*)0);
-    glEnableVertexAttribArray(0);
-
-    // 2nd attribute buffer : colors
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,  sizeof(Vertex),  (GLvoid*)(3 * sizeof(GLfloat)) );
-    glEnableVertexAttribArray(1);
-
-    // 3rd attribute buffer : uvs
-    glVertexAttribPointer(2, 2,  GL_FLOAT, GL_FALSE, sizeof( Vertex ), (GLvoid*)( 6 * sizeof( GLfloat ) ));
-    glEnableVertexAttribArray(2);
-
-    //Second buffer - holds the indices (Element Array Buffer - EAB):
-    glGenBuffers(1, &mEAB);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEAB);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mIndices.size() * sizeof(GLuint), mIndices.data(), GL_STATIC_DRAW);
-
-    glBindVertexArray(0);
+    //The mesh is loaded on the loader thread of the MeshCache, and uploaded by MeshCache::update()
 }
 
-void ObjMesh::readFile(std::string filename)
+void ObjMesh::draw()
 {
-    //Open File
-    std::string fileWithPath = gsl::assetFilePath + "Meshes/" + filename;
-    std::ifstream fileIn;
-    fileIn.open (fileWithPath, std::ifstream::in);
-    if(!fileIn)
-        qDebug() << "Could not open file for reading: " << QString::fromStdString(filename);
-
-    //One line at a time-variable
-    std::string oneLine;
-    //One word at a time-variable
-    std::string oneWord;
-
-    std::vector<gsl::Vector3D> tempVertecies;
-    std::vector<gsl::Vector3D> tempNormals;
-    std::vector<gsl::Vector2D> tempUVs;
-
-    //    std::vector<Vertex> mVertices;    //made in VisualObject
-    //    std::vector<GLushort> mIndices;   //made in VisualObject
-
-    // Varible for constructing the indices vector
-    unsigned int temp_index = 0;
-
-    //Reading one line at a time from file to oneLine
-    while(std::getline(fileIn, oneLine))
+    //Not loaded yet, or the file could not be read
+    if (!mMesh || !mMesh->mUploaded || mMesh->mIndexCount == 0)
+        return;
+    glUseProgram(mMaterial.mShader->getProgram());
+    glBindVertexArray( mMesh->mVAO );
+    if (mMesh->mLayout == VertexLayout::Packed)
     {
-        //Doing a trick to get one word at a time
-        std::stringstream sStream;
-        //Pushing line into stream
-        sStream << oneLine;
-        //Streaming one word out of line
-        oneWord = ""; //resetting the value or else the last value might survive!
-        sStream >> oneWord;
-
-        if (oneWord == "#")
-        {
-            //Ignore this line
-            //            qDebug() << "Line is comment "  << QString::fromStdString(oneWord);
-            continue;
-        }
-        if (oneWord == "")
-        {
-            //Ignore this line
-            //            qDebug() << "Line is blank ";
-            continue;
-        }
-        if (oneWord == "v")
-        {
-            //            qDebug() << "Line is vertex "  << QString::fromStdString(oneWord) << " ";
-            gsl::Vector3D tempVertex;
-            sStream >> oneWord;
-            tempVertex.x = std::stof(oneWord);
-            sStream >> oneWord;
-            tempVertex.y = std::stof(oneWord);
-            sStream >> oneWord;
-            tempVertex.z = std::stof(oneWord);
-
-            //Vertex made - pushing it into vertex-vector
-            tempVertecies.push_back(tempVertex);
-
-            continue;
-        }
-        if (oneWord == "vt")
-        {
-            //            qDebug() << "Line is UV-coordinate "  << QString::fromStdString(oneWord) << " ";
-            gsl::Vector2D tempUV;
-            sStream >> oneWord;
-            tempUV.x = std::stof(oneWord);
-            sStream >> oneWord;
-            tempUV.y = std::stof(oneWord);
-
-            //UV made - pushing it into UV-vector
-            tempUVs.push_back(tempUV);
-
-            continue;
-        }
-        if (oneWord == "vn")
-        {
-            //            qDebug() << "Line is normal "  << QString::fromStdString(oneWord) << " ";
-            gsl::Vector3D tempNormal;
-            sStream >> oneWord;
-            tempNormal.x = std::stof(oneWord);
-            sStream >> oneWord;
-            tempNormal.y = std::stof(oneWord);
-            sStream >> oneWord;
-            tempNormal.z = std::stof(oneWord);
-
-            //Vertex made - pushing it into vertex-vector
-            tempNormals.push_back(tempNormal);
-            continue;
-        }
-        if (oneWord == "f")
-        {
-            //            qDebug() << "Line is a face "  << QString::fromStdString(oneWord) << " ";
-            //int slash; //used to get the / from the v/t/n - format
-            int index, normal, uv;
-            for(int i = 0; i < 3; i++)
-            {
-                sStream >> oneWord;     //one word read
-                std::stringstream tempWord(oneWord);    //to use getline on this one word
-                std::string segment;    //the numbers in the f-line
-                std::vector<std::string> segmentArray;  //temp array of the numbers
-                while(std::getline(tempWord, segment, '/')) //splitting word in segments
-                {
-                    segmentArray.push_back(segment);
-                }
-                index = std::stoi(segmentArray[0]);     //first is vertex
-                if (segmentArray[1] != "")              //second is uv
-                    uv = std::stoi(segmentArray[1]);
-                else
-                {
-                    //qDebug() << "No uvs in mesh";       //uv not present
-                    uv = 0;                             //this will become -1 in a couple of lines
-                }
-                normal = std::stoi(segmentArray[2]);    //third is normal
-
-                //Fixing the indexes
-                //because obj f-lines starts with 1, not 0
-                --index;
-                --uv;
-                --normal;
-
-                if (uv > -1)    //uv present!
-                {
-                    Vertex tempVert(tempVertecies[index], tempNormals[normal], tempUVs[uv]);
-                    mVertices.push_back(tempVert);
-                }
-                else            //no uv in mesh data, use 0, 0 as uv
-                {
-                    Vertex tempVert(tempVertecies[index], tempNormals[normal], gsl::Vector2D(0.0f, 0.0f));
-                    mVertices.push_back(tempVert);
-                }
-                mIndices.push_back(temp_index++);
-            }
-
-            //For some reason the winding order is backwards so fixing this by swapping the last two indices
-            //Update: this was because the matrix library was wrong - now it is corrected so this is no longer needed.
-//            unsigned int back = mIndices.size() - 1;
-//            std::swap(mIndices.at(back), mIndices.at(back-1));
-            continue;
-        }
+        //Packed positions are relative to the bounding box of the mesh
+        gsl::Matrix4x4 modelMatrix = mMatrix * mMesh->mPositionTransform;
+        mMaterial.mShader->transmitUniformData(&modelMatrix, &mMaterial);
     }
-
-    //beeing a nice boy and closing the file after use
-    fileIn.close();
-    qDebug() << "Obj file read: " << QString::fromStdString(filename);
+    else
+        mMaterial.mShader->transmitUniformData(&mMatrix, &mMaterial);
+
+    //Fewer triangles when far away. All the levels are in the same index buffer.
+    const MeshLod &lod = mMeshCache->selectLod(*mMesh, worldBounds(), *mMaterial.mShader->getCurrentCamera());
+    std::size_t indexSize = mMesh->mIndexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(lod.indexCount), mMesh->mIndexType,
+                   reinterpret_cast<const GLvoid*>(lod.indexOffset * indexSize));
+//    glBindVertexArray(0);
 }
 
-void ObjMesh::draw()
+const Bounds &ObjMesh::localBounds() const
 {
-    glUseProgram(mMaterial.mShader->getProgram());
-    glBindVertexArray( mVAO );
-    mMaterial.mShader->transmitUniformData(&mMatrix, &mMaterial);
-    glDrawElements(GL_TRIANGLES, mIndices.size(), GL_UNSIGNED_INT, nullptr);
-//    glBindVertexArray(0);
+    if (mMesh && mMesh->mUploaded)
+        return mMesh->mBounds;
+    return mLocalBounds;
 }
@@ -2,18 +2,30 @@
 #define OBJMESH_H
 #include "visualobject.h"
 
+class MeshCache;
+struct MeshResource;
 
+/**
+ * Object drawn with a mesh from the Meshes folder.
+ * The mesh and its GPU buffers come from a MeshCache and are shared with every other
+ * ObjMesh using the same file - each ObjMesh only has its own matrix and material.
+ */
 class ObjMesh : public VisualObject
 {
 public:
     ObjMesh();
-    ObjMesh(std::string filename);
+    ObjMesh(const std::string &filename, MeshCache *meshCache, Residency residency = Residency::DropAfterUpload);
     ~ObjMesh() override;
 
     virtual void draw() override;
     virtual void init() override;
 
-    void readFile(std::string filename);
+    //The bounds of the mesh, empty until it is loaded
+    virtual const Bounds &localBounds() const override;
+
+private:
+    MeshCache *mMeshCache{nullptr};
+    MeshResource *mMesh{nullptr};
 };
 
 #endif // OBJMESH_H
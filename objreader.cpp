@@ -0,0 +1,699 @@
+#include "innpch.h"
+#include "objreader.h"
+#include <QFile>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+    //All the helpers take the current position by reference and the end of the data.
+    //The data is not zero terminated, so nothing may read at or past end.
+
+    inline bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline void skipBlanks(const char *&pos, const char *end)
+    {
+        while (pos < end && isBlank(*pos))
+            ++pos;
+    }
+
+    //Moves to the first character of the next line
+    inline void skipLine(const char *&pos, const char *end)
+    {
+        const void *newline = std::memchr(pos, '\n', static_cast<std::size_t>(end - pos));
+        pos = newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    inline bool atLineEnd(const char *pos, const char *end)
+    {
+        return pos == end || *pos == '\n' || *pos == '#';
+    }
+
+#if !defined(__cpp_lib_to_chars)
+    //Plain decimal float parser for standard libraries without floating point from_chars.
+    //Can be off by one ulp compared to std::stof.
+    const char *parseDecimal(const char *pos, const char *end, GLfloat &value)
+    {
+        const char *start = pos;
+        bool negative = false;
+        if (pos < end && (*pos == '-' || *pos == '+'))
+            negative = *pos++ == '-';
+
+        double mantissa = 0.0;
+        int exponent = 0;
+        bool anyDigits = false;
+        for (; pos < end && isDigit(*pos); ++pos, anyDigits = true)
+            mantissa = mantissa * 10.0 + (*pos - '0');
+        if (pos < end && *pos == '.')
+        {
+            for (++pos; pos < end && isDigit(*pos); ++pos, anyDigits = true)
+            {
+                mantissa = mantissa * 10.0 + (*pos - '0');
+                --exponent;
+            }
+        }
+        if (!anyDigits)
+            return start;
+
+        if (pos < end && (*pos == 'e' || *pos == 'E'))
+        {
+            const char *exponentStart = pos++;
+            bool negativeExponent = false;
+            if (pos < end && (*pos == '-' || *pos == '+'))
+                negativeExponent = *pos++ == '-';
+            if (pos < end && isDigit(*pos))
+            {
+                int e = 0;
+                for (; pos < end && isDigit(*pos); ++pos)
+                    e = std::min(e * 10 + (*pos - '0'), 1000);
+                exponent += negativeExponent ? -e : e;
+            }
+            else
+                pos = exponentStart;    //"1e" is the number 1 followed by junk
+        }
+
+        double result = mantissa * std::pow(10.0, exponent);
+        value = static_cast<GLfloat>(negative ? -result : result);
+        return pos;
+    }
+#endif
+
+    bool parseFloat(const char *&pos, const char *end, GLfloat &value)
+    {
+        skipBlanks(pos, end);
+#if defined(__cpp_lib_to_chars)
+        //from_chars doesn't accept a leading '+', obj exporters sometimes write one
+        const char *start = pos;
+        if (pos < end && *pos == '+')
+            ++pos;
+        auto result = std::from_chars(pos, end, value);
+        if (result.ec != std::errc())
+        {
+            pos = start;
+            return false;
+        }
+        pos = result.ptr;
+        return true;
+#else
+        const char *next = parseDecimal(pos, end, value);
+        if (next == pos)
+            return false;
+        pos = next;
+        return true;
+#endif
+    }
+
+    bool parseInt(const char *&pos, const char *end, long &value)
+    {
+        const char *p = pos;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+        if (p == end || !isDigit(*p))
+            return false;
+
+        long result = 0;
+        for (; p < end && isDigit(*p); ++p)
+        {
+            if (result > (std::numeric_limits<long>::max() - 9) / 10)
+                return false;
+            result = result * 10 + (*p - '0');
+        }
+        value = negative ? -result : result;
+        pos = p;
+        return true;
+    }
+
+    //Obj indices start at 1, negative ones count back from the last element read so far.
+    //Returns false if the index points outside the elements read.
+    inline bool resolveIndex(long objIndex, std::size_t count, std::size_t &index)
+    {
+        if (objIndex > 0 && static_cast<std::size_t>(objIndex) <= count)
+        {
+            index = static_cast<std::size_t>(objIndex - 1);
+            return true;
+        }
+        if (objIndex < 0 && static_cast<std::size_t>(-objIndex) <= count)
+        {
+            index = count - static_cast<std::size_t>(-objIndex);
+            return true;
+        }
+        return false;
+    }
+
+
+    //One corner of a face, as zero based indices. None if the corner has no uv or normal.
+    struct Corner
+    {
+        static constexpr GLuint None = std::numeric_limits<GLuint>::max();
+        GLuint position;
+        GLuint uv;
+        GLuint normal;
+
+        bool operator==(const Corner &other) const
+        {
+            return position == other.position && uv == other.uv && normal == other.normal;
+        }
+    };
+
+    struct CornerHash
+    {
+        std::size_t operator()(const Corner &corner) const
+        {
+            //Multiply-add with the 64 bit golden ratio, then fold the high bits down
+            //so the low bits the buckets use depend on all three indices
+            constexpr std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+            std::uint64_t hash = corner.position;
+            hash = hash * multiplier + corner.uv;
+            hash = hash * multiplier + corner.normal;
+            return static_cast<std::size_t>(hash ^ (hash >> 29));
+        }
+    };
+
+    inline Vertex makeVertex(const Corner &corner, const gsl::Vector3D *positions, const gsl::Vector2D *uvs,
+                             const gsl::Vector3D *normals)
+    {
+        gsl::Vector3D normal = corner.normal != Corner::None ? normals[corner.normal] : gsl::Vector3D(0.f, 0.f, 0.f);
+        gsl::Vector2D uv = corner.uv != Corner::None ? uvs[corner.uv] : gsl::Vector2D(0.f, 0.f);
+        return Vertex(positions[corner.position], normal, uv);
+    }
+
+    enum class Keyword { Position, Uv, Normal, Face, Other };
+
+    //Reads the first word of a line. pos must be at a character that is not blank or a line end.
+    inline Keyword readKeyword(const char *&pos, const char *end)
+    {
+        const char *keyword = pos;
+        while (pos < end && !isBlank(*pos) && *pos != '\n')
+            ++pos;
+        std::size_t length = static_cast<std::size_t>(pos - keyword);
+
+        if (keyword[0] == 'v')
+        {
+            if (length == 1)
+                return Keyword::Position;
+            if (length == 2 && keyword[1] == 't')
+                return Keyword::Uv;
+            if (length == 2 && keyword[1] == 'n')
+                return Keyword::Normal;
+        }
+        else if (keyword[0] == 'f' && length == 1)
+        {
+            return Keyword::Face;
+        }
+        return Keyword::Other;
+    }
+
+    /**
+     * Parses the lines in [pos, end) and hands what it finds to the sink:
+     * position(), uv() and normal() for the v, vt and vn lines, and face() with the corners of each f line.
+     * positionCount(), uvCount() and normalCount() must give the number read before the current line,
+     * counting from the start of the file, so indices can be checked and negative ones resolved.
+     * lineNumber is the number of the line before pos, and is left at the line with the error.
+     * @return nullptr, or what was wrong
+     */
+    template <typename Sink>
+    const char *parseLines(const char *pos, const char *end, Sink &sink, std::vector<Corner> &corners,
+                           std::size_t &lineNumber)
+    {
+        while (pos < end)
+        {
+            ++lineNumber;
+            skipBlanks(pos, end);
+            if (atLineEnd(pos, end))
+            {
+                skipLine(pos, end);
+                continue;
+            }
+
+            switch (readKeyword(pos, end))
+            {
+            case Keyword::Position:
+            {
+                gsl::Vector3D position;
+                if (!parseFloat(pos, end, position.x) || !parseFloat(pos, end, position.y) ||
+                        !parseFloat(pos, end, position.z))
+                    return "expected three numbers after v";
+                sink.position(position);
+                break;
+            }
+            case Keyword::Uv:
+            {
+                gsl::Vector2D uv;
+                if (!parseFloat(pos, end, uv.x) || !parseFloat(pos, end, uv.y))
+                    return "expected two numbers after vt";
+                sink.uv(uv);
+                break;
+            }
+            case Keyword::Normal:
+            {
+                gsl::Vector3D normal;
+                if (!parseFloat(pos, end, normal.x) || !parseFloat(pos, end, normal.y) ||
+                        !parseFloat(pos, end, normal.z))
+                    return "expected three numbers after vn";
+                sink.normal(normal);
+                break;
+            }
+            case Keyword::Face:
+            {
+                corners.clear();
+                for (;;)
+                {
+                    skipBlanks(pos, end);
+                    if (atLineEnd(pos, end))
+                        break;
+
+                    //v, v/vt, v//vn or v/vt/vn
+                    std::size_t position;
+                    std::size_t uv = Corner::None;
+                    std::size_t normal = Corner::None;
+                    long objIndex;
+                    if (!parseInt(pos, end, objIndex) || !resolveIndex(objIndex, sink.positionCount(), position))
+                        return "invalid vertex index in face";
+                    if (pos < end && *pos == '/')
+                    {
+                        ++pos;
+                        if (pos < end && *pos != '/')
+                        {
+                            if (!parseInt(pos, end, objIndex) || !resolveIndex(objIndex, sink.uvCount(), uv))
+                                return "invalid uv index in face";
+                        }
+                        if (pos < end && *pos == '/')
+                        {
+                            ++pos;
+                            if (!parseInt(pos, end, objIndex) || !resolveIndex(objIndex, sink.normalCount(), normal))
+                                return "invalid normal index in face";
+                        }
+                    }
+                    if (pos < end && !isBlank(*pos) && *pos != '\n')
+                        return "unexpected character in face";
+                    corners.push_back({static_cast<GLuint>(position), static_cast<GLuint>(uv), static_cast<GLuint>(normal)});
+                }
+                if (corners.size() < 3)
+                    return "face with less than three corners";
+                sink.face(corners);
+                break;
+            }
+            case Keyword::Other:
+                //o, g, s, usemtl, mtllib ... are not used
+                break;
+            }
+
+            skipLine(pos, end);
+        }
+        return nullptr;
+    }
+
+    //Welds the corners as the faces come, straight into the mesh
+    struct SequentialSink
+    {
+        explicit SequentialSink(MeshData &outMesh) : mesh(outMesh) {}
+
+        MeshData &mesh;
+        std::vector<gsl::Vector3D> positions;
+        std::vector<gsl::Vector3D> normals;
+        std::vector<gsl::Vector2D> uvs;
+        std::vector<GLuint> faceVertices;   //reused for every face
+        std::size_t cornerCount{0};
+
+        //Each distinct v/vt/vn triple becomes one vertex, in the order they are first used
+        std::unordered_map<Corner, GLuint, CornerHash> vertexIndices;
+
+        std::size_t positionCount() const { return positions.size(); }
+        std::size_t uvCount() const { return uvs.size(); }
+        std::size_t normalCount() const { return normals.size(); }
+
+        void position(const gsl::Vector3D &position) { positions.push_back(position); }
+        void uv(const gsl::Vector2D &uv) { uvs.push_back(uv); }
+        void normal(const gsl::Vector3D &normal) { normals.push_back(normal); }
+
+        void face(const std::vector<Corner> &corners)
+        {
+            //Most files have all the v lines first, so this is about the number of vertices we end up with
+            if (vertexIndices.empty())
+                vertexIndices.reserve(positions.size());
+
+            faceVertices.clear();
+            for (const Corner &corner : corners)
+            {
+                auto inserted = vertexIndices.emplace(corner, static_cast<GLuint>(mesh.vertices.size()));
+                if (inserted.second)
+                    mesh.vertices.push_back(makeVertex(corner, positions.data(), uvs.data(), normals.data()));
+                faceVertices.push_back(inserted.first->second);
+            }
+            cornerCount += corners.size();
+
+            //Polygons are split into a fan of triangles
+            for (std::size_t i = 2; i < faceVertices.size(); i++)
+            {
+                mesh.indices.push_back(faceVertices[0]);
+                mesh.indices.push_back(faceVertices[i - 1]);
+                mesh.indices.push_back(faceVertices[i]);
+            }
+        }
+    };
+
+    //A piece of the file, parsed by one thread. The first* members are where the chunk starts
+    //in the whole file, summed up from the counts of the chunks before it.
+    struct Chunk
+    {
+        const char *begin;
+        const char *end;
+
+        //Counting pass
+        std::size_t lineCount{0};
+        std::size_t positionCount{0};
+        std::size_t uvCount{0};
+        std::size_t normalCount{0};
+        std::size_t firstLine{0};
+        std::size_t firstPosition{0};
+        std::size_t firstUv{0};
+        std::size_t firstNormal{0};
+
+        //Parsing pass. The corners are kept until welding.
+        std::vector<Corner> corners;
+        std::vector<GLuint> faceSizes;
+        std::size_t triangleCount{0};
+        std::size_t firstCorner{0};
+        std::size_t firstTriangle{0};
+        const char *error{nullptr};
+        std::size_t errorLine{0};
+
+        //Welding
+        std::size_t newVertexCount{0};
+        std::size_t firstVertex{0};
+    };
+
+    void countChunk(Chunk &chunk)
+    {
+        const char *pos = chunk.begin;
+        while (pos < chunk.end)
+        {
+            ++chunk.lineCount;
+            skipBlanks(pos, chunk.end);
+            if (!atLineEnd(pos, chunk.end))
+            {
+                switch (readKeyword(pos, chunk.end))
+                {
+                case Keyword::Position: ++chunk.positionCount; break;
+                case Keyword::Uv: ++chunk.uvCount; break;
+                case Keyword::Normal: ++chunk.normalCount; break;
+                default: break;
+                }
+            }
+            skipLine(pos, chunk.end);
+        }
+    }
+
+    //Writes the elements straight into their place in the arrays for the whole file,
+    //which the counting pass has sized. Faces are kept in the chunk.
+    struct ChunkSink
+    {
+        Chunk &chunk;
+        gsl::Vector3D *positions;
+        gsl::Vector2D *uvs;
+        gsl::Vector3D *normals;
+        std::size_t nextPosition;
+        std::size_t nextUv;
+        std::size_t nextNormal;
+
+        std::size_t positionCount() const { return nextPosition; }
+        std::size_t uvCount() const { return nextUv; }
+        std::size_t normalCount() const { return nextNormal; }
+
+        void position(const gsl::Vector3D &position) { positions[nextPosition++] = position; }
+        void uv(const gsl::Vector2D &uv) { uvs[nextUv++] = uv; }
+        void normal(const gsl::Vector3D &normal) { normals[nextNormal++] = normal; }
+
+        void face(const std::vector<Corner> &corners)
+        {
+            chunk.corners.insert(chunk.corners.end(), corners.begin(), corners.end());
+            chunk.faceSizes.push_back(static_cast<GLuint>(corners.size()));
+            chunk.triangleCount += corners.size() - 2;
+        }
+    };
+
+    //Calls function(i) for i in [0, count), spread over threadCount threads including this one
+    template <typename Function>
+    void parallelFor(std::size_t count, unsigned threadCount, Function function)
+    {
+        std::atomic<std::size_t> next{0};
+        auto work = [&]() {
+            for (std::size_t i = next++; i < count; i = next++)
+                function(i);
+        };
+
+        std::vector<std::thread> threads;
+        std::size_t extraThreads = std::min<std::size_t>(threadCount, count);
+        for (std::size_t i = 1; i < extraThreads; i++)
+            threads.emplace_back(work);
+        work();
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    //Smaller files are parsed on one thread - starting threads would take longer than the parsing
+    constexpr std::size_t MinChunkSize = 256 * 1024;
+    constexpr unsigned ChunksPerThread = 4;     //evens out chunks that take longer than the others
+
+} //namespace
+
+bool ObjReader::readFile(const std::string &filePath, MeshData &mesh, Statistics *statistics, unsigned threadCount)
+{
+    mesh.clear();
+
+    QFile file(QString::fromStdString(filePath));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Could not open file for reading: " << QString::fromStdString(filePath);
+        return false;
+    }
+
+    qint64 size = file.size();
+    if (size == 0)
+        return true;
+
+    //The mapping stays valid until it is unmapped or the file is closed
+    const uchar *mapped = file.map(0, size);
+    if (mapped)
+    {
+        bool ok = parse(reinterpret_cast<const char*>(mapped), static_cast<std::size_t>(size), mesh, filePath,
+                        statistics, threadCount);
+        file.unmap(const_cast<uchar*>(mapped));
+        return ok;
+    }
+
+    //Some file systems (ex. Qt resources) can't be mapped - read the whole file instead
+    QByteArray bytes = file.readAll();
+    return parse(bytes.constData(), static_cast<std::size_t>(bytes.size()), mesh, filePath, statistics, threadCount);
+}
+
+bool ObjReader::parse(const char *data, std::size_t size, MeshData &mesh, const std::string &name,
+                      Statistics *statistics, unsigned threadCount)
+{
+    mesh.clear();
+    if (statistics)
+        *statistics = Statistics();
+
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunkCount = std::min<std::size_t>(threadCount * ChunksPerThread, size / MinChunkSize);
+    if (threadCount > 1 && chunkCount > 1)
+        return parseParallel(data, size, mesh, name, statistics, threadCount, chunkCount);
+
+    SequentialSink sink(mesh);
+    std::vector<Corner> corners;
+    std::size_t lineNumber = 0;
+    if (const char *error = parseLines(data, data + size, sink, corners, lineNumber))
+    {
+        qDebug() << "Obj file" << QString::fromStdString(name) << "line" << static_cast<qulonglong>(lineNumber)
+                 << ":" << error;
+        mesh.clear();
+        return false;
+    }
+
+    if (statistics)
+    {
+        statistics->faceCorners = sink.cornerCount;
+        statistics->vertices = mesh.vertices.size();
+        statistics->triangles = mesh.indices.size() / 3;
+    }
+    return true;
+}
+
+bool ObjReader::parseParallel(const char *data, std::size_t size, MeshData &mesh, const std::string &name,
+                              Statistics *statistics, unsigned threadCount, std::size_t chunkCount)
+{
+    //Split at line ends, about the same size each
+    const char *end = data + size;
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunkCount);
+    const char *chunkBegin = data;
+    for (std::size_t i = 1; i <= chunkCount && chunkBegin < end; i++)
+    {
+        const char *chunkEnd = data + size * i / chunkCount;
+        if (chunkEnd < chunkBegin)
+            chunkEnd = chunkBegin;
+        if (i < chunkCount)
+            skipLine(chunkEnd, end);
+        else
+            chunkEnd = end;
+        if (chunkEnd > chunkBegin)
+        {
+            chunks.emplace_back();
+            chunks.back().begin = chunkBegin;
+            chunks.back().end = chunkEnd;
+        }
+        chunkBegin = chunkEnd;
+    }
+
+    //First pass only counts the v, vt and vn lines, so each chunk knows where its elements go
+    //and which indices its faces may use - the same as reading the file from the start
+    parallelFor(chunks.size(), threadCount, [&](std::size_t i) { countChunk(chunks[i]); });
+
+    std::size_t lineCount = 0;
+    std::size_t positionCount = 0;
+    std::size_t uvCount = 0;
+    std::size_t normalCount = 0;
+    for (Chunk &chunk : chunks)
+    {
+        chunk.firstLine = lineCount;
+        chunk.firstPosition = positionCount;
+        chunk.firstUv = uvCount;
+        chunk.firstNormal = normalCount;
+        lineCount += chunk.lineCount;
+        positionCount += chunk.positionCount;
+        uvCount += chunk.uvCount;
+        normalCount += chunk.normalCount;
+    }
+
+    std::vector<gsl::Vector3D> positions(positionCount);
+    std::vector<gsl::Vector2D> uvs(uvCount);
+    std::vector<gsl::Vector3D> normals(normalCount);
+
+    parallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        Chunk &chunk = chunks[i];
+        ChunkSink sink{chunk, positions.data(), uvs.data(), normals.data(),
+                    chunk.firstPosition, chunk.firstUv, chunk.firstNormal};
+        std::vector<Corner> corners;
+        std::size_t lineNumber = chunk.firstLine;
+        chunk.error = parseLines(chunk.begin, chunk.end, sink, corners, lineNumber);
+        chunk.errorLine = lineNumber;
+    });
+
+    std::size_t cornerCount = 0;
+    std::size_t triangleCount = 0;
+    for (Chunk &chunk : chunks)
+    {
+        if (chunk.error)
+        {
+            qDebug() << "Obj file" << QString::fromStdString(name) << "line" << static_cast<qulonglong>(chunk.errorLine)
+                     << ":" << chunk.error;
+            return false;
+        }
+        chunk.firstCorner = cornerCount;
+        chunk.firstTriangle = triangleCount;
+        cornerCount += chunk.corners.size();
+        triangleCount += chunk.triangleCount;
+    }
+    if (cornerCount >= Corner::None)
+    {
+        qDebug() << "Obj file" << QString::fromStdString(name) << ": too many face corners";
+        return false;
+    }
+
+    //Welding, split on the hash of the corners: each thread welds the corners in its own buckets
+    //with its own map, going through the corners in file order. firstUse is the number of the first
+    //corner with the same v/vt/vn, so the result is the same as welding on one thread.
+    std::vector<GLuint> firstUse(cornerCount);
+    std::size_t bucketCount = threadCount;
+    parallelFor(bucketCount, threadCount, [&](std::size_t bucket) {
+        CornerHash hash;
+        std::unordered_map<Corner, GLuint, CornerHash> vertexIndices;
+        vertexIndices.reserve(positionCount / bucketCount + 1);
+        for (const Chunk &chunk : chunks)
+        {
+            GLuint cornerNumber = static_cast<GLuint>(chunk.firstCorner);
+            for (const Corner &corner : chunk.corners)
+            {
+                if (hash(corner) % bucketCount == bucket)
+                    firstUse[cornerNumber] = vertexIndices.emplace(corner, cornerNumber).first->second;
+                ++cornerNumber;
+            }
+        }
+    });
+
+    //The corners that are used first become the vertices, numbered in file order
+    parallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        Chunk &chunk = chunks[i];
+        for (std::size_t c = 0; c < chunk.corners.size(); c++)
+        {
+            std::size_t cornerNumber = chunk.firstCorner + c;
+            if (firstUse[cornerNumber] == cornerNumber)
+                ++chunk.newVertexCount;
+        }
+    });
+    std::size_t vertexCount = 0;
+    for (Chunk &chunk : chunks)
+    {
+        chunk.firstVertex = vertexCount;
+        vertexCount += chunk.newVertexCount;
+    }
+
+    std::vector<GLuint> cornerVertex(cornerCount);
+    mesh.vertices.resize(vertexCount);
+    parallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        const Chunk &chunk = chunks[i];
+        std::size_t vertexNumber = chunk.firstVertex;
+        for (std::size_t c = 0; c < chunk.corners.size(); c++)
+        {
+            std::size_t cornerNumber = chunk.firstCorner + c;
+            if (firstUse[cornerNumber] == cornerNumber)
+            {
+                cornerVertex[cornerNumber] = static_cast<GLuint>(vertexNumber);
+                mesh.vertices[vertexNumber++] = makeVertex(chunk.corners[c], positions.data(), uvs.data(), normals.data());
+            }
+        }
+    });
+
+    //Polygons are split into a fan of triangles
+    mesh.indices.resize(triangleCount * 3);
+    parallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        const Chunk &chunk = chunks[i];
+        GLuint *indices = mesh.indices.data() + chunk.firstTriangle * 3;
+        std::size_t cornerNumber = chunk.firstCorner;
+        for (GLuint faceSize : chunk.faceSizes)
+        {
+            GLuint first = cornerVertex[firstUse[cornerNumber]];
+            for (GLuint c = 2; c < faceSize; c++)
+            {
+                *indices++ = first;
+                *indices++ = cornerVertex[firstUse[cornerNumber + c - 1]];
+                *indices++ = cornerVertex[firstUse[cornerNumber + c]];
+            }
+            cornerNumber += faceSize;
+        }
+    });
+
+    if (statistics)
+    {
+        statistics->faceCorners = cornerCount;
+        statistics->vertices = vertexCount;
+        statistics->triangles = triangleCount;
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef OBJREADER_H
+#define OBJREADER_H
+
+#include <cstddef>
+#include <string>
+#include "meshdata.h"
+
+/**
+ * Reads Wavefront .obj files into MeshData.
+ * The file is memory mapped and parsed in one pass straight from the mapped bytes,
+ * without copying lines or words into strings.
+ *
+ * Corners with the same v/vt/vn triple share one vertex, so the index buffer
+ * is a real indexed mesh and not one vertex per corner.
+ *
+ * Supports v, vt and vn lines and f lines with v, v/vt, v//vn or v/vt/vn corners,
+ * negative (relative) indices and polygons, which are split into triangles.
+ * Everything else (o, g, s, usemtl, mtllib ...) is skipped.
+ * A corner without normal or uv gets (0, 0, 0) or (0, 0).
+ *
+ * Large files can be parsed on several threads: the text is split into chunks at line ends,
+ * the chunks are parsed at the same time and the results joined. The mesh is exactly the same
+ * as when parsed on one thread.
+ */
+class ObjReader
+{
+public:
+    struct Statistics
+    {
+        std::size_t faceCorners{0};     //vertices there would be without welding
+        std::size_t vertices{0};        //after welding
+        std::size_t triangles{0};
+    };
+
+    /**
+     * Read an obj file from disk
+     * @param filePath Full path to the file
+     * @param mesh Gets the vertices and indices. Cleared first.
+     * @param statistics Optional, gets the vertex counts before and after welding
+     * @param threadCount Threads to parse with, 0 for one per processor core.
+     * Files smaller than about half a megabyte are always parsed on one thread.
+     * @return false if the file could not be opened or has invalid data
+     */
+    static bool readFile(const std::string &filePath, MeshData &mesh, Statistics *statistics = nullptr,
+                         unsigned threadCount = 1);
+
+    /**
+     * Parse obj text already in memory. The text does not need to be zero terminated.
+     * @param name Used in error messages
+     */
+    static bool parse(const char *data, std::size_t size, MeshData &mesh, const std::string &name = "",
+                      Statistics *statistics = nullptr, unsigned threadCount = 1);
+
+private:
+    static bool parseParallel(const char *data, std::size_t size, MeshData &mesh, const std::string &name,
+                              Statistics *statistics, unsigned threadCount, std::size_t chunkCount);
+};
+
+#endif // OBJREADER_H
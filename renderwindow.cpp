@@ -11,8 +11,10 @@
 #include "boat.h"
 #include "colorshader.h"
 #include "mainwindow.h"
+#include "meshcache.h"
 #include "objmesh.h"
 #include "textureshader.h"
+#include "texturecache.h"
 
 RenderWindow::RenderWindow(const QSurfaceFormat &format, MainWindow *mainWindow)
     : mContext(nullptr), mMainWindow(mainWindow)
@@ -39,6 +41,8 @@ RenderWindow::~RenderWindow()
     for (auto &i : mShaderProgram) {
         delete i;
     }
+    delete mMeshCache;
+    delete mTextureCache;
 }
 
 /// Sets up the general OpenGL stuff and the buffers needed to render a triangle
@@ -90,16 +94,13 @@ void RenderWindow::init()
 
     //**********************  Texture stuff: **********************
 
-    mTexture[0] = new Texture("white.bmp");
-    mTexture[1] = new Texture("hund.bmp", 1);
-    //Set the textures loaded to a texture unit
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, mTexture[0]->id());
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, mTexture[1]->id());
+    //Materials get their textures from the cache and bind them when drawn
+    mTextureCache = new TextureCache();
 
     //********************** Making the objects to be drawn **********************
 
+    mMeshCache = new MeshCache();
+    mMeshCache->setVertexLayout(VertexLayout::Packed);
     MakePlane();
 
     mBoat = new Boat(gsl::Vector3D(0.f, 10.f, 0.f));
@@ -107,7 +108,7 @@ void RenderWindow::init()
     mBoat->setShader(mShaderProgram[0]);
     mBoat->mName = "boat";
     mBoat->mRenderWindow = this;
-    mBoat->mMaterial.setTextureUnit(0);
+    mBoat->mMaterial.setTexture(mTextureCache->acquire("white.bmp"));
     mBoat->mMaterial.mObjectColor = gsl::Vector3D(0.1f, 0.1f, 0.8f);
     mVisualObjects.push_back(mBoat);
 
@@ -138,6 +139,11 @@ void RenderWindow::render()
     //to clear the screen for each redraw
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    //Meshes loaded since the last frame get their buffers, objects draw them when ready
+    mMeshCache->update();
+    //Textures stream in the same way - the placeholder is drawn until the upload is done
+    mTextureCache->update();
+
     for (auto visObject : mVisualObjects) {
         visObject->draw();
         //        checkForGLerrors();
@@ -175,81 +181,27 @@ void RenderWindow::setupTextureShader(int shaderIndex)
 
 void RenderWindow::MakePlane()
 {
-    VisualObject *temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(0, 0, 0);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    // Adding some more 2D squares -- would benefit from a resource manager here
-    // if plane.obj was a larger file, since we're essentially
-    // re-reading the plane.obj file each time we create a new object.
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(300, 0, 300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(00, 0, 300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(300, 0, 0);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(-300, 0, 0);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(0, 0, -300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(-300, 0, 300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(300, 0, -300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
-    temp = new ObjMesh("plane.obj");
-    temp->init();
-    temp->setShader(mShaderProgram[1]);
-    temp->mMaterial.setTextureUnit(1);
-    //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
-    temp->mMatrix.setPosition(-300, 0, -300);
-    temp->mMatrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
-    mVisualObjects.push_back(temp);
+    //All the planes share one mesh and one texture from the caches, so plane.obj and hund.bmp
+    //are read and uploaded only once
+    std::shared_ptr<Texture> texture = mTextureCache->acquire("hund.bmp");
+    const gsl::Vector3D positions[] = {
+        {0.f, 0.f, 0.f}, {300.f, 0.f, 300.f}, {0.f, 0.f, 300.f},
+        {300.f, 0.f, 0.f}, {-300.f, 0.f, 0.f}, {0.f, 0.f, -300.f},
+        {-300.f, 0.f, 300.f}, {300.f, 0.f, -300.f}, {-300.f, 0.f, -300.f}
+    };
+    for (const gsl::Vector3D &position : positions)
+    {
+        VisualObject *temp = new ObjMesh("plane.obj", mMeshCache);
+        temp->init();
+        temp->setShader(mShaderProgram[1]);
+        temp->mMaterial.setTexture(texture);
+        //temp->mMaterial.mObjectColor = gsl::Vector3D(0.0f, 0.0f, 0.f);
+        gsl::Matrix4x4 matrix(true);
+        matrix.setPosition(position.x, position.y, position.z);
+        matrix.scale(gsl::Vector3D(150.f, 1.f, 150.f));
+        temp->setMatrix(matrix);
+        mVisualObjects.push_back(temp);
+    }
 }
 
 //This function is called from Qt when window is exposed (shown)
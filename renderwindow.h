@@ -14,6 +14,8 @@ class QOpenGLContext;
 class Shader;
 class MainWindow;
 class Boat;
+class MeshCache;
+class TextureCache;
 
 /// This inherits from QWindow to get access to the Qt functionality and
 /// OpenGL surface.
@@ -42,8 +44,9 @@ private:
     QOpenGLContext *mContext{nullptr};
     bool mInitialized{false};
 
-    Texture *mTexture[4]{nullptr};      //We can hold 4 textures
     Shader *mShaderProgram[4]{nullptr}; //We can hold 4 shaders
+    MeshCache *mMeshCache{nullptr};     //meshes shared by the objects
+    TextureCache *mTextureCache{nullptr};   //textures shared by the materials
 
     void setupPlainShader(int shaderIndex);
     GLint mMatrixUniform0{-1};
@@ -2,37 +2,23 @@
 #include <QImage>
 #include <QBuffer>
 #include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
 
 #include "texture.h"
 
 Texture::Texture(GLuint textureUnit) : QOpenGLFunctions_4_1_Core()
 {
     initializeOpenGLFunctions();
-    //small dummy texture
-    for (int i=0; i<16; i++)
-        pixels[i] = 0;
-    pixels[0] = 255;
-    pixels[4] = 255;
-    pixels[8] = 255;
-    pixels[9] = 255;
-    pixels[10] = 255;
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    glGenTextures(1, &mId);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, mId);
-    qDebug() << "Texture::Texture() id = " << mId;
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 2, 2, 0, GL_RGB, GL_UNSIGNED_BYTE,
-                 reinterpret_cast<const GLvoid*>(pixels));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     setTexture(textureUnit);
+    uploadDummy();
 }
 
 /**
- \brief Texture::Texture() Read a bitmap file and create a texture with standard parameters
- \param filename The name of the bmp file containing a texture
+ \brief Texture::Texture() Read a texture file and create a texture with standard parameters
+ \param filename The name of the bmp, dds or ktx file containing a texture.
+ For a bmp file, a dds or ktx file with the same name is used instead if there is one.
+ \param sampler Wrap and filter modes
  First one 2D texture is generated from
  - glGenTextures()
  Then the OpenGL functions
@@ -41,11 +27,29 @@ Texture::Texture(GLuint textureUnit) : QOpenGLFunctions_4_1_Core()
  - glTexImage2D()
  are used. The texture can be retrieved later by using the function id()
  */
-Texture::Texture(const std::string& filename, GLuint textureUnit): QOpenGLFunctions_4_1_Core()
+Texture::Texture(const std::string& filename, GLuint textureUnit, const TextureSampler &sampler)
+    : QOpenGLFunctions_4_1_Core(), mSampler{sampler}
 {
     initializeOpenGLFunctions();
-    readBitmap(filename);
     setTexture(textureUnit);
+    if (!readTexture(filename))
+        uploadDummy();
+}
+
+/**
+ \brief Texture::Texture() The 2x2 placeholder, until TextureCache has streamed in the real texture
+ */
+Texture::Texture(const TextureSampler &sampler) : QOpenGLFunctions_4_1_Core(), mSampler{sampler}
+{
+    initializeOpenGLFunctions();
+    setTexture(0);
+    uploadDummy();
+}
+
+Texture::~Texture()
+{
+    glDeleteTextures(1, &mId);
+    glDeleteTextures(1, &mStreamedId);
 }
 
 /**
@@ -57,40 +61,234 @@ GLuint Texture::id() const
     return mId;
 }
 
-void Texture::readBitmap(const std::string &filename)
+std::vector<std::string> Texture::candidateFiles(const std::string &filename)
 {
-    OBITMAPFILEHEADER bmFileHeader;
-    OBITMAPINFOHEADER bmInfoHeader;
-
     std::string fileWithPath =  gsl::assetFilePath + "Textures/" + filename;
 
-    std::ifstream file;
-    file.open (fileWithPath.c_str(), std::ifstream::in | std::ifstream::binary);
-    if (file.is_open())
+    //A block compressed version of a bitmap is used instead of it if there is one, and the driver takes it
+    std::vector<std::string> files;
+    std::size_t dot = fileWithPath.find_last_of('.');
+    if (dot != std::string::npos && !isCompressedFile(fileWithPath))
+    {
+        for (const char *compressedExtension : {".dds", ".ktx"})
+        {
+            std::string compressedFile = fileWithPath.substr(0, dot) + compressedExtension;
+            if (QFileInfo(QString::fromStdString(compressedFile)).exists())
+                files.push_back(compressedFile);
+        }
+    }
+    files.push_back(fileWithPath);
+    return files;
+}
+
+bool Texture::readTexture(const std::string &filename)
+{
+    for (const std::string &file : candidateFiles(filename))
+    {
+        if (readFile(file, isCompressedFile(file) ? &Texture::uploadCompressed : &Texture::uploadBitmap))
+            return true;
+    }
+    return false;
+}
+
+bool Texture::isCompressedFile(const std::string &fileWithPath)
+{
+    std::size_t dot = fileWithPath.find_last_of('.');
+    if (dot == std::string::npos)
+        return false;
+    std::string extension = QString::fromStdString(fileWithPath.substr(dot + 1)).toLower().toStdString();
+    return extension == "dds" || extension == "ktx";
+}
+
+bool Texture::readFile(const std::string &fileWithPath,
+                       bool (Texture::*upload)(const unsigned char *, std::size_t, const std::string &))
+{
+    QFile file(QString::fromStdString(fileWithPath));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Can not read " << QString(fileWithPath.c_str());
+        return false;
+    }
+
+    //The pixels go to OpenGL straight from the mapped file, which is unmapped when the upload is done
+    qint64 size = file.size();
+    const uchar *mapped = file.map(0, size);
+    if (mapped)
+    {
+        bool ok = (this->*upload)(mapped, static_cast<std::size_t>(size), fileWithPath);
+        file.unmap(const_cast<uchar*>(mapped));
+        return ok;
+    }
+
+    //Some file systems (ex. Qt resources) can't be mapped - read the whole file instead
+    QByteArray bytes = file.readAll();
+    return (this->*upload)(reinterpret_cast<const unsigned char*>(bytes.constData()),
+                           static_cast<std::size_t>(bytes.size()), fileWithPath);
+}
+
+/**
+ \brief Texture::uploadCompressed() Upload a DDS or KTX file in memory to the bound texture
+ */
+bool Texture::uploadCompressed(const unsigned char *data, std::size_t size, const std::string &name)
+{
+    CompressedImage image;
+    bool ok = textureformat::isKtx(data, size) ? textureformat::readKtx(data, size, image, name)
+                                               : textureformat::readDds(data, size, image, name);
+    return ok && uploadImage(image, name);
+}
+
+/**
+ \brief Texture::uploadBitmap() Upload a bmp file in memory to the bound texture
+ Most bitmaps are given to glTexImage2D as they are, with GL_BGR / GL_BGRA as the source format - no copy.
+ Channel orders OpenGL can't take are shuffled to RGBA with gsl::simd::shuffleBytes4 first.
+ */
+bool Texture::uploadBitmap(const unsigned char *data, std::size_t size, const std::string &name)
+{
+    BitmapImage image;
+    if (!textureformat::readBitmap(data, size, image, name))
+        return false;
+
+    std::vector<unsigned char> shuffled;
+    if (image.shuffle)
     {
-        file.read((char *) &bmFileHeader, 14);
+        shuffled.resize(textureformat::bitmapSize(image));
+        image = textureformat::copyBitmap(image, shuffled.data());
+    }
+    uploadImage(image, name);
+    return true;
+}
 
-        file.read((char *) &bmInfoHeader, sizeof(OBITMAPINFOHEADER));
-        mColumns = bmInfoHeader.biWidth;
-        mRows = bmInfoHeader.biHeight;
-        mnByte = bmInfoHeader.biBitCount / 8;
+/**
+ \brief Texture::uploadImage() Upload the mip levels of a block compressed image to the bound texture
+ The levels are given to glCompressedTexImage2D as they are - no decoding, no copy, and no glGenerateMipmap.
+ The level data may also be offsets into a bound GL_PIXEL_UNPACK_BUFFER.
+ \return false if the driver does not support the format
+ */
+bool Texture::uploadImage(const CompressedImage &image, const std::string &name)
+{
+    //Clear old errors, so the check below is only about this upload
+    while (glGetError() != GL_NO_ERROR)
+        ;
 
-        mBitmap = new unsigned char[mColumns * mRows * mnByte];
-        file.read((char *) mBitmap, mColumns * mRows * mnByte);
-        file.close();
+    std::size_t bytes = 0;
+    for (std::size_t level = 0; level < image.levels.size(); level++)
+    {
+        const CompressedLevel &mip = image.levels[level];
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.format, mip.width, mip.height, 0,
+                               static_cast<GLsizei>(mip.size), mip.data);
+        if (level == 0 && glGetError() != GL_NO_ERROR)
+        {
+            qDebug() << "Texture: " << QString(name.c_str()) << textureformat::formatName(image.format)
+                     << "is not supported by the driver";
+            return false;
+        }
+        bytes += mip.size;
+    }
+    //Only the levels in the file - the texture is incomplete if OpenGL expects more
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+
+    mColumns = image.levels.front().width;
+    mRows = image.levels.front().height;
+    mnByte = 0;     //blocks, not whole bytes per texel
+    mGpuBytes = bytes;
+    qDebug() << "Texture read: " << QString(name.c_str()) << "-" << textureformat::formatName(image.format) << ","
+             << image.levels.size() << "mip levels";
+    return true;
+}
+
+/**
+ \brief Texture::uploadImage() Upload a bitmap to the bound texture, and let OpenGL make the mipmaps
+ The bitmap must not need a shuffle. The pixels may also be an offset into a bound GL_PIXEL_UNPACK_BUFFER.
+ */
+void Texture::uploadImage(const BitmapImage &image, const std::string &name)
+{
+    mColumns = image.width;
+    mRows = image.height;
+    mnByte = image.format == GL_BGR ? 3 : 4;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (!image.topDown)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, image.internalFormat, mColumns, mRows, 0, image.format, GL_UNSIGNED_BYTE,
+                     image.pixels);
     }
     else
     {
-        qDebug() << "Can not read " << QString(fileWithPath.c_str());
+        //Top-down rows are given to OpenGL one at a time from the last, instead of flipping a copy
+        glTexImage2D(GL_TEXTURE_2D, 0, image.internalFormat, mColumns, mRows, 0, image.format, GL_UNSIGNED_BYTE,
+                     nullptr);
+        for (int row = 0; row < mRows; row++)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, mColumns, 1, image.format, GL_UNSIGNED_BYTE,
+                            image.pixels + static_cast<std::size_t>(mRows - 1 - row) * image.rowSize);
+        }
     }
-    unsigned char tmp;
-    // switch red and blue
-    for (int k = 0; k < mColumns * mRows * mnByte; k += mnByte) {
-        tmp = mBitmap[k];
-        mBitmap[k] = mBitmap[k + 2];
-        mBitmap[k + 2] = tmp;
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    //Drivers usually pad RGB8 texels to 4 bytes. The mipmaps add a third.
+    mGpuBytes = static_cast<std::size_t>(mColumns) * static_cast<std::size_t>(mRows) * 4 * 4 / 3;
+    qDebug() << "Texture read: " << QString(name.c_str());
+}
+
+/**
+ \brief Texture::uploadStreamed() Upload a streamed image into a new texture object, used by TextureCache
+ Give either bitmap or compressed. The data is offsets into the bound GL_PIXEL_UNPACK_BUFFER.
+ The texture keeps showing what it has until swapStreamed(), so drawing never waits for the upload.
+ \return false if the driver does not take the image
+ */
+bool Texture::uploadStreamed(const BitmapImage *bitmap, const CompressedImage *compressed, const std::string &name)
+{
+    GLuint shown = mId;
+    setTexture(0);
+    bool ok = true;
+    if (bitmap)
+        uploadImage(*bitmap, name);
+    else
+        ok = uploadImage(*compressed, name);
+    mStreamedId = mId;
+    mId = shown;
+
+    if (!ok)
+    {
+        glDeleteTextures(1, &mStreamedId);
+        mStreamedId = 0;
     }
-    qDebug() << "Texture read: " << QString(fileWithPath.c_str());
+    return ok;
+}
+
+/**
+ \brief Texture::swapStreamed() Start drawing the texture from uploadStreamed(), once OpenGL is done with it
+ */
+void Texture::swapStreamed()
+{
+    glDeleteTextures(1, &mId);
+    mId = mStreamedId;
+    mStreamedId = 0;
+}
+
+/**
+ \brief Texture::uploadDummy() Upload a small 2x2 texture to the bound texture
+ Used by the basic texture, and when a file can't be read
+ */
+void Texture::uploadDummy()
+{
+    for (int i=0; i<16; i++)
+        pixels[i] = 0;
+    pixels[0] = 255;
+    pixels[4] = 255;
+    pixels[8] = 255;
+    pixels[9] = 255;
+    pixels[10] = 255;
+
+    mColumns = 2;
+    mRows = 2;
+    mnByte = 3;
+    mGpuBytes = 2 * 2 * 4;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 2, 2, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                 reinterpret_cast<const GLvoid*>(pixels));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 }
 
 void Texture::setTexture(GLuint textureUnit)
@@ -100,19 +298,8 @@ void Texture::setTexture(GLuint textureUnit)
     glActiveTexture(GL_TEXTURE0 + textureUnit);
     glBindTexture(GL_TEXTURE_2D, mId);
     qDebug() << "Texture::Texture() id = " << mId;
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                GL_RGB,
-                mColumns,
-                mRows,
-                0,
-                GL_RGB,
-                GL_UNSIGNED_BYTE,
-                mBitmap);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, mSampler.mWrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, mSampler.mWrapT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mSampler.mMagFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mSampler.mMinFilter);
 }
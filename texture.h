@@ -2,9 +2,28 @@
 #define TEXTURE_H
 
 #include <QOpenGLFunctions_4_1_Core>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "textureformat.h"
+
+//How a texture is sampled. Part of the TextureCache key, so the same image with other settings is another texture.
+struct TextureSampler
+{
+    GLint mWrapS{GL_REPEAT};
+    GLint mWrapT{GL_REPEAT};
+    GLint mMinFilter{GL_LINEAR};
+    GLint mMagFilter{GL_LINEAR};
+
+    bool operator==(const TextureSampler &other) const
+    {
+        return mWrapS == other.mWrapS && mWrapT == other.mWrapT &&
+               mMinFilter == other.mMinFilter && mMagFilter == other.mMagFilter;
+    }
+};
 
 /**
-    \brief Simple class for creating textures from a bitmap file.
+    \brief Simple class for creating textures from a bitmap, or a block compressed DDS or KTX file.
     \author Dag Nylund
     \date 16/02/05
  */
@@ -13,48 +32,43 @@ class Texture : protected QOpenGLFunctions_4_1_Core
 private:
     GLubyte pixels[16];
     GLuint mId{0};
-    unsigned char *mBitmap;
-    int mColumns;
-    int mRows;
-    int mnByte;
-    void readBitmap(const std::string& filename);
+    GLuint mStreamedId{0};      //uploaded by TextureCache, waiting for swapStreamed()
+    int mColumns{0};
+    int mRows{0};
+    int mnByte{0};
+    std::size_t mGpuBytes{0};
+    TextureSampler mSampler;
+    bool readTexture(const std::string& filename);
+    //Full paths to try for filename, best first - see the constructor
+    static std::vector<std::string> candidateFiles(const std::string &filename);
+    static bool isCompressedFile(const std::string &fileWithPath);
+    bool readFile(const std::string &fileWithPath,
+                  bool (Texture::*upload)(const unsigned char *, std::size_t, const std::string &));
+    bool uploadBitmap(const unsigned char *data, std::size_t size, const std::string &name);
+    bool uploadCompressed(const unsigned char *data, std::size_t size, const std::string &name);
+    bool uploadImage(const CompressedImage &image, const std::string &name);
+    void uploadImage(const BitmapImage &image, const std::string &name);
+    void uploadDummy();
     void setTexture(GLuint textureUnit);
+
+    //Streaming, used by TextureCache
+    friend class TextureCache;
+    explicit Texture(const TextureSampler &sampler);     //the placeholder, until the file is streamed in
+    bool uploadStreamed(const BitmapImage *bitmap, const CompressedImage *compressed, const std::string &name);
+    void swapStreamed();
 public:
     Texture(GLuint textureUnit = 0);  //basic texture from code
-    Texture(const std::string &filename, GLuint textureUnit = 0);
+    Texture(const std::string &filename, GLuint textureUnit = 0, const TextureSampler &sampler = TextureSampler());
+    ~Texture();
+    Texture(const Texture&) = delete;
+    Texture &operator=(const Texture&) = delete;
     GLuint id() const;
+    int width() const { return mColumns; }
+    int height() const { return mRows; }
+
+    //Video memory used, estimated from the size and format, with the mipmaps
+    std::size_t gpuBytes() const { return mGpuBytes; }
 
-private:
-    //this is put inside this class to avoid spamming the main namespace
-    //with stuff that only is used inside this class
-
-    //Quick fix to get rid of windows.h which contains
-    //BITMAPINFOHEADER and BITMAPFILEHEADER.
-    typedef unsigned short int OWORD;    //should be 16 bit
-    typedef unsigned int ODWORD;         //should be 32 bit
-    typedef int OLONG;                   //should be 32 bit
-
-    struct OBITMAPINFOHEADER {
-        ODWORD biSize;
-        OLONG  biWidth;
-        OLONG  biHeight;
-        OWORD  biPlanes;
-        OWORD  biBitCount;
-        ODWORD biCompression;
-        ODWORD biSizeImage;
-        OLONG  biXPelsPerMeter;
-        OLONG  biYPelsPerMeter;
-        ODWORD biClrUsed;
-        ODWORD biClrImportant;
-    };
-
-    struct OBITMAPFILEHEADER {
-        OWORD  bfType;
-        ODWORD bfSize;
-        OWORD  bfReserved1;
-        OWORD  bfReserved2;
-        ODWORD bfOffBits;
-    };
 };
 
 #endif // TEXTURE_H
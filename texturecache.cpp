@@ -0,0 +1,361 @@
+#include "innpch.h"
+#include "texturecache.h"
+#include <cstring>
+#include <functional>
+
+std::size_t TextureCache::KeyHash::operator()(const Key &key) const
+{
+    std::size_t hash = std::hash<std::string>()(key.mFileName);
+    for (GLint value : {key.mSampler.mWrapS, key.mSampler.mWrapT, key.mSampler.mMinFilter, key.mSampler.mMagFilter})
+        hash = hash * 31 + std::hash<GLint>()(value);
+    return hash;
+}
+
+TextureCache::TextureCache()
+{
+    //must call this to use OpenGL functions
+    initializeOpenGLFunctions();
+}
+
+TextureCache::~TextureCache()
+{
+    //Streams still queued are never read. One being read or filled is finished first.
+    if (mLoader.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopLoader = true;
+        }
+        mWakeLoader.notify_one();
+        mLoader.join();
+    }
+
+    for (auto &stream : mToLoader)
+        destroy(*stream);
+    for (auto &stream : mFromLoader)
+        destroy(*stream);
+    for (auto &stream : mStreams)
+        destroy(*stream);
+}
+
+std::shared_ptr<Texture> TextureCache::acquire(const std::string &filename, const TextureSampler &sampler)
+{
+    Key key{filename, sampler};
+    auto found = mTextures.find(key);
+    if (found != mTextures.end())
+    {
+        if (std::shared_ptr<Texture> texture = found->second.lock())
+            return texture;
+    }
+
+    //Loading is rare, so this is a good time to forget textures no one uses any more
+    removeExpired();
+
+    //The placeholder is drawn until the stream is done
+    std::shared_ptr<Texture> texture(new Texture(sampler));
+    mTextures[key] = texture;
+
+    auto stream = std::make_unique<TextureStream>();
+    stream->mTexture = texture;
+    stream->mFileName = filename;
+    stream->mFiles = Texture::candidateFiles(filename);
+    toLoader(std::move(stream));
+    return texture;
+}
+
+void TextureCache::toLoader(std::unique_ptr<TextureStream> stream)
+{
+    if (!mLoader.joinable())
+        mLoader = std::thread(&TextureCache::loaderLoop, this);
+
+    mStreamsAtLoader++;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mToLoader.push_back(std::move(stream));
+    }
+    mWakeLoader.notify_one();
+}
+
+void TextureCache::loaderLoop()
+{
+    for (;;)
+    {
+        std::unique_ptr<TextureStream> stream;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeLoader.wait(lock, [this] { return mStopLoader || !mToLoader.empty(); });
+            if (mStopLoader)
+                return;
+            stream = std::move(mToLoader.front());
+            mToLoader.pop_front();
+        }
+
+        if (stream->mStep == TextureStream::Step::Read)
+            read(*stream);
+        else
+            fill(*stream);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFromLoader.push_back(std::move(stream));
+    }
+}
+
+//Runs on the loader thread
+void TextureCache::read(TextureStream &stream)
+{
+    for (; stream.mFile < stream.mFiles.size(); stream.mFile++)
+    {
+        const std::string &fileWithPath = stream.mFiles[stream.mFile];
+        stream.mSource.close();
+        stream.mContents.clear();
+        stream.mSource.setFileName(QString::fromStdString(fileWithPath));
+        if (!stream.mSource.open(QIODevice::ReadOnly))
+        {
+            qDebug() << "Can not read " << QString(fileWithPath.c_str());
+            continue;
+        }
+
+        //The mapping stays valid until the file is closed, after fill()
+        qint64 fileSize = stream.mSource.size();
+        const unsigned char *data = stream.mSource.map(0, fileSize);
+        std::size_t size = static_cast<std::size_t>(fileSize);
+        if (!data)
+        {
+            //Some file systems (ex. Qt resources) can't be mapped - read the whole file instead
+            stream.mContents = stream.mSource.readAll();
+            data = reinterpret_cast<const unsigned char*>(stream.mContents.constData());
+            size = static_cast<std::size_t>(stream.mContents.size());
+        }
+
+        stream.mCompressed = Texture::isCompressedFile(fileWithPath);
+        bool ok;
+        if (stream.mCompressed)
+        {
+            ok = textureformat::isKtx(data, size) ? textureformat::readKtx(data, size, stream.mCompressedImage, fileWithPath)
+                                                  : textureformat::readDds(data, size, stream.mCompressedImage, fileWithPath);
+            stream.mBytes = 0;
+            for (const CompressedLevel &level : stream.mCompressedImage.levels)
+                stream.mBytes += level.size;
+        }
+        else
+        {
+            ok = textureformat::readBitmap(data, size, stream.mBitmap, fileWithPath);
+            stream.mBytes = textureformat::bitmapSize(stream.mBitmap);
+        }
+
+        if (ok)
+        {
+            stream.mStep = TextureStream::Step::Map;
+            return;
+        }
+    }
+
+    stream.mSource.close();
+    stream.mContents.clear();
+    stream.mFailed = true;
+}
+
+//Runs on the loader thread. The pixels are decoded straight into the mapped pixel buffer,
+//and the images are changed to point at offsets in it, like glTexImage2D wants with a bound buffer.
+void TextureCache::fill(TextureStream &stream)
+{
+    if (stream.mCompressed)
+    {
+        std::size_t offset = 0;
+        for (CompressedLevel &level : stream.mCompressedImage.levels)
+        {
+            std::memcpy(stream.mBuffer + offset, level.data, level.size);
+            level.data = reinterpret_cast<const unsigned char*>(offset);
+            offset += level.size;
+        }
+    }
+    else
+    {
+        //Flips top-down bitmaps, and shuffles the channels if OpenGL can't take them as they are
+        stream.mBitmap = textureformat::copyBitmap(stream.mBitmap, stream.mBuffer);
+        stream.mBitmap.pixels = nullptr;
+    }
+
+    stream.mSource.close();
+    stream.mContents.clear();
+    stream.mStep = TextureStream::Step::Upload;
+}
+
+void TextureCache::update()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (!mFromLoader.empty())
+        {
+            mStreams.push_back(std::move(mFromLoader.front()));
+            mFromLoader.pop_front();
+            mStreamsAtLoader--;
+        }
+    }
+    if (mStreams.empty())
+        return;
+
+    std::size_t mappedBytes = 0;
+    std::vector<std::unique_ptr<TextureStream>> waiting;
+    for (std::unique_ptr<TextureStream> &stream : mStreams)
+    {
+        //Dropped by all its users while it was streaming
+        std::shared_ptr<Texture> texture = stream->mTexture.lock();
+        if (!texture || stream->mFailed)
+        {
+            if (texture)
+                qDebug() << "Texture: no file could be read for" << QString::fromStdString(stream->mFileName);
+            destroy(*stream);
+            continue;
+        }
+
+        switch (stream->mStep)
+        {
+        case TextureStream::Step::Map:
+            if (mappedBytes > 0 && mappedBytes + stream->mBytes > mUploadBudget)
+            {
+                waiting.push_back(std::move(stream));
+                break;
+            }
+            mappedBytes += stream->mBytes;
+            if (mapBuffer(*stream))
+                toLoader(std::move(stream));
+            else
+                destroy(*stream);
+            break;
+        case TextureStream::Step::Upload:
+            if (upload(*stream, *texture))
+                waiting.push_back(std::move(stream));
+            else if (stream->mStep == TextureStream::Step::Read)
+                toLoader(std::move(stream));
+            else
+                destroy(*stream);
+            break;
+        case TextureStream::Step::Wait:
+            if (swapWhenUploaded(*stream, *texture))
+                destroy(*stream);
+            else
+                waiting.push_back(std::move(stream));
+            break;
+        default:
+            break;
+        }
+    }
+    mStreams.swap(waiting);
+
+    if (!isStreaming())
+        logMemoryReport();
+}
+
+//Makes a pixel buffer the size of the image and maps it for the loader thread to write into
+bool TextureCache::mapBuffer(TextureStream &stream)
+{
+    glGenBuffers(1, &stream.mPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream.mPBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(stream.mBytes), nullptr, GL_STREAM_DRAW);
+    stream.mBuffer = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+                                                                  static_cast<GLsizeiptr>(stream.mBytes),
+                                                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!stream.mBuffer)
+    {
+        qDebug() << "Texture: could not map a pixel buffer for" << QString::fromStdString(stream.mFileName);
+        return false;
+    }
+    stream.mStep = TextureStream::Step::Fill;
+    return true;
+}
+
+//Starts the upload from the pixel buffer, and sets a fence after it.
+//If the driver does not take the image, the stream goes back to Step::Read with the next file to try.
+bool TextureCache::upload(TextureStream &stream, Texture &texture)
+{
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream.mPBO);
+    //The buffer contents can be lost while mapped, ex. on a display mode change - then read the file again
+    bool intact = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    stream.mBuffer = nullptr;
+
+    const std::string &name = stream.mFiles[stream.mFile];
+    bool ok = intact && texture.uploadStreamed(stream.mCompressed ? nullptr : &stream.mBitmap,
+                                               stream.mCompressed ? &stream.mCompressedImage : nullptr, name);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!ok)
+    {
+        glDeleteBuffers(1, &stream.mPBO);
+        stream.mPBO = 0;
+        if (intact)
+            stream.mFile++;
+        stream.mStep = TextureStream::Step::Read;
+        stream.mFailed = stream.mFile >= stream.mFiles.size();
+        return false;
+    }
+
+    stream.mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    stream.mStep = TextureStream::Step::Wait;
+    return true;
+}
+
+bool TextureCache::swapWhenUploaded(TextureStream &stream, Texture &texture)
+{
+    //Never blocks - the flush makes sure the fence is signaled some time, so this does not wait forever
+    GLenum status = glClientWaitSync(stream.mFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    texture.swapStreamed();
+    return true;
+}
+
+void TextureCache::destroy(TextureStream &stream)
+{
+    if (stream.mBuffer)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream.mPBO);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        stream.mBuffer = nullptr;
+    }
+    glDeleteBuffers(1, &stream.mPBO);
+    stream.mPBO = 0;
+    if (stream.mFence)
+        glDeleteSync(stream.mFence);
+    stream.mFence = nullptr;
+    stream.mSource.close();
+}
+
+std::size_t TextureCache::textureCount() const
+{
+    std::size_t count = 0;
+    for (const auto &entry : mTextures)
+        count += entry.second.expired() ? 0 : 1;
+    return count;
+}
+
+std::size_t TextureCache::gpuBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto &entry : mTextures)
+    {
+        if (std::shared_ptr<Texture> texture = entry.second.lock())
+            bytes += texture->gpuBytes();
+    }
+    return bytes;
+}
+
+void TextureCache::logMemoryReport() const
+{
+    qDebug() << "Texture memory:" << textureCount() << "textures," << gpuBytes() / 1024 << "KiB on the GPU";
+}
+
+void TextureCache::removeExpired()
+{
+    for (auto entry = mTextures.begin(); entry != mTextures.end();)
+    {
+        if (entry->second.expired())
+            entry = mTextures.erase(entry);
+        else
+            ++entry;
+    }
+}
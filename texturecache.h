@@ -0,0 +1,150 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QOpenGLFunctions_4_1_Core>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "texture.h"
+#include "textureformat.h"
+
+/**
+ * A texture on its way from the file to the GPU. Owned by TextureCache, and handed between
+ * the render thread and the loader thread under its mutex - only one of them uses it at a time.
+ */
+struct TextureStream
+{
+    enum class Step
+    {
+        Read,       //loader thread: map the file and read the header
+        Map,        //render thread: make the pixel buffer and map it
+        Fill,       //loader thread: copy the pixels into the pixel buffer
+        Upload,     //render thread: upload from the pixel buffer into a new texture object
+        Wait        //render thread: wait for the upload fence, then swap the new texture object in
+    };
+
+    std::weak_ptr<Texture> mTexture;    //the stream is dropped if no one uses the texture any more
+    std::string mFileName;              //as given to acquire()
+    std::vector<std::string> mFiles;    //full paths to try, best first - see Texture::candidateFiles()
+    std::size_t mFile{0};               //the one being tried
+    Step mStep{Step::Read};
+    bool mFailed{false};                //no file could be used, the placeholder stays
+
+    //The file, mapped - or read into mContents if it can't be mapped - until the pixels are in the buffer
+    QFile mSource;
+    QByteArray mContents;
+    bool mCompressed{false};
+    BitmapImage mBitmap;
+    CompressedImage mCompressedImage;
+    std::size_t mBytes{0};              //size of the pixel buffer
+
+    GLuint mPBO{0};                     //GL_PIXEL_UNPACK_BUFFER
+    unsigned char *mBuffer{nullptr};    //mapped mPBO, written by the loader thread
+    GLsync mFence{nullptr};             //signaled when OpenGL is done uploading from mPBO
+};
+
+/**
+ * Loads each texture once and shares it between all the materials that use it.
+ * Keyed by file name and sampler settings, so the same image with other wrap or filter modes
+ * is another texture.
+ *
+ * acquire() gives a shared handle - the reference count is the shared_ptr's. The texture is deleted
+ * when the last material lets go of it, and the cache only keeps a weak pointer to find it again.
+ *
+ * Textures are streamed in, so acquire() and the frame loop never wait for a file:
+ * acquire() returns a 2x2 placeholder at once, and the loader thread reads the file.
+ * update() maps a pixel buffer object for it, the loader thread decodes the pixels straight into that buffer,
+ * and update() starts the upload into a new texture object. When a fence says OpenGL is done,
+ * the texture switches to the new object, so drawing never stalls on an upload in progress.
+ *
+ * Made and used on the render thread, while the OpenGL context is current.
+ */
+class TextureCache : protected QOpenGLFunctions_4_1_Core
+{
+public:
+    TextureCache();
+    ~TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache &operator=(const TextureCache&) = delete;
+
+    /**
+     * Get a texture from the Textures folder. If no one uses it yet, it is queued for streaming,
+     * and the texture is the 2x2 placeholder until it is done.
+     * If the file can't be read the placeholder stays.
+     * @param filename File name inside gsl::assetFilePath + "Textures/"
+     */
+    std::shared_ptr<Texture> acquire(const std::string &filename, const TextureSampler &sampler = TextureSampler());
+
+    //Call once a frame: moves the streams along, and swaps in the textures that are done
+    void update();
+
+    //True while some textures are still being streamed
+    bool isStreaming() const { return !mStreams.empty() || mStreamsAtLoader > 0; }
+
+    //Bytes of pixels update() may start streaming in one frame. At least one texture is started each frame.
+    void setUploadBudget(std::size_t bytesPerFrame) { mUploadBudget = bytesPerFrame; }
+
+    //Textures in use
+    std::size_t textureCount() const;
+
+    //Estimated video memory of the textures in use - see Texture::gpuBytes()
+    std::size_t gpuBytes() const;
+
+    void logMemoryReport() const;
+
+private:
+    struct Key
+    {
+        std::string mFileName;
+        TextureSampler mSampler;
+
+        bool operator==(const Key &other) const { return mFileName == other.mFileName && mSampler == other.mSampler; }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    //Forgets the textures whose last user is gone. Called when a new texture is loaded.
+    void removeExpired();
+
+    void loaderLoop();
+    void toLoader(std::unique_ptr<TextureStream> stream);
+
+    //Loader thread steps
+    void read(TextureStream &stream);
+    void fill(TextureStream &stream);
+
+    //Render thread steps, return true when the stream is done
+    bool mapBuffer(TextureStream &stream);
+    bool upload(TextureStream &stream, Texture &texture);
+    bool swapWhenUploaded(TextureStream &stream, Texture &texture);
+    void destroy(TextureStream &stream);
+
+    std::size_t mUploadBudget{16 * 1024 * 1024};
+
+    //Loader thread. mToLoader and mFromLoader are shared with it, under mMutex.
+    std::thread mLoader;
+    std::mutex mMutex;
+    std::condition_variable mWakeLoader;
+    std::deque<std::unique_ptr<TextureStream>> mToLoader;
+    std::deque<std::unique_ptr<TextureStream>> mFromLoader;
+    bool mStopLoader{false};
+
+    //Only used on the render thread
+    std::vector<std::unique_ptr<TextureStream>> mStreams;   //waiting for a render thread step
+    std::size_t mStreamsAtLoader{0};
+
+    std::unordered_map<Key, std::weak_ptr<Texture>, KeyHash> mTextures;
+};
+
+#endif // TEXTURECACHE_H
@@ -0,0 +1,389 @@
+#include "innpch.h"
+#include "textureformat.h"
+#include "gsl_simd.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace textureformat
+{
+    namespace
+    {
+        inline std::uint32_t readUint32(const unsigned char *data)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        constexpr std::uint32_t fourCC(char a, char b, char c, char d)
+        {
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) |
+                   (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+                   (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16) |
+                   (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+        }
+
+        //DDS: the "DDS " magic, then a 124 byte header, then a 20 byte DX10 header if the four cc is "DX10"
+        constexpr std::size_t DdsHeaderEnd = 4 + 124;
+        constexpr std::size_t DdsDx10HeaderEnd = DdsHeaderEnd + 20;
+        constexpr std::uint32_t DdsMipMapCountFlag = 0x20000;
+        constexpr std::uint32_t DdsFourCCFlag = 0x4;
+
+        //DXGI_FORMAT values from the DX10 header
+        GLenum formatFromDxgi(std::uint32_t dxgiFormat)
+        {
+            switch (dxgiFormat)
+            {
+            case 71: return BC1;
+            case 72: return BC1_SRGB;
+            case 77: return BC3;
+            case 78: return BC3_SRGB;
+            case 83: return BC5;
+            case 98: return BC7;
+            case 99: return BC7_SRGB;
+            default: return 0;
+            }
+        }
+
+        //KTX 1: a 12 byte identifier, then 13 uint32 fields
+        constexpr unsigned char KtxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+        constexpr std::size_t KtxHeaderEnd = 64;
+        constexpr std::uint32_t KtxSameEndianness = 0x04030201;
+
+        inline std::size_t levelSize(GLenum format, GLsizei width, GLsizei height)
+        {
+            std::size_t blocksX = (static_cast<std::size_t>(width) + 3) / 4;
+            std::size_t blocksY = (static_cast<std::size_t>(height) + 3) / 4;
+            return blocksX * blocksY * blockBytes(format);
+        }
+
+        //Levels stop at 1x1 no matter what the file says
+        unsigned clampLevelCount(std::uint32_t levelCount, GLsizei width, GLsizei height)
+        {
+            unsigned maxLevels = 1;
+            for (GLsizei size = std::max(width, height); size > 1; size /= 2)
+                maxLevels++;
+            return std::max(1u, std::min(static_cast<unsigned>(levelCount), maxLevels));
+        }
+
+        //Quick fix to get rid of windows.h which contains
+        //BITMAPINFOHEADER and BITMAPFILEHEADER.
+        typedef unsigned short int OWORD;    //should be 16 bit
+        typedef unsigned int ODWORD;         //should be 32 bit
+        typedef int OLONG;                   //should be 32 bit
+
+        struct OBITMAPINFOHEADER {
+            ODWORD biSize;
+            OLONG  biWidth;
+            OLONG  biHeight;
+            OWORD  biPlanes;
+            OWORD  biBitCount;
+            ODWORD biCompression;
+            ODWORD biSizeImage;
+            OLONG  biXPelsPerMeter;
+            OLONG  biYPelsPerMeter;
+            ODWORD biClrUsed;
+            ODWORD biClrImportant;
+        };
+
+        //biCompression values
+        constexpr ODWORD OBI_RGB{0};
+        constexpr ODWORD OBI_BITFIELDS{3};
+        constexpr ODWORD OBI_ALPHABITFIELDS{6};
+
+        struct OBITMAPFILEHEADER {
+            OWORD  bfType;
+            ODWORD bfSize;
+            OWORD  bfReserved1;
+            OWORD  bfReserved2;
+            ODWORD bfOffBits;
+        };
+
+        constexpr std::size_t BitmapFileHeaderSize = 14;
+
+        bool fail(const std::string &name, const char *reason)
+        {
+            qDebug() << "Texture: " << QString::fromStdString(name) << reason;
+            return false;
+        }
+    }
+
+    std::size_t blockBytes(GLenum format)
+    {
+        switch (format)
+        {
+        case BC1:
+        case BC1_SRGB:
+            return 8;
+        case BC3:
+        case BC3_SRGB:
+        case BC5:
+        case BC7:
+        case BC7_SRGB:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    const char *formatName(GLenum format)
+    {
+        switch (format)
+        {
+        case BC1: return "BC1";
+        case BC1_SRGB: return "BC1 sRGB";
+        case BC3: return "BC3";
+        case BC3_SRGB: return "BC3 sRGB";
+        case BC5: return "BC5";
+        case BC7: return "BC7";
+        case BC7_SRGB: return "BC7 sRGB";
+        default: return "unknown";
+        }
+    }
+
+    bool isDds(const unsigned char *data, std::size_t size)
+    {
+        return size >= 4 && readUint32(data) == fourCC('D', 'D', 'S', ' ');
+    }
+
+    bool isKtx(const unsigned char *data, std::size_t size)
+    {
+        return size >= sizeof(KtxIdentifier) && std::memcmp(data, KtxIdentifier, sizeof(KtxIdentifier)) == 0;
+    }
+
+    bool readDds(const unsigned char *data, std::size_t size, CompressedImage &image, const std::string &name)
+    {
+        image = CompressedImage();
+        if (!isDds(data, size) || size < DdsHeaderEnd || readUint32(data + 4) != 124)
+            return fail(name, "is not a DDS file");
+
+        std::uint32_t flags = readUint32(data + 8);
+        GLsizei height = static_cast<GLsizei>(readUint32(data + 12));
+        GLsizei width = static_cast<GLsizei>(readUint32(data + 16));
+        std::uint32_t levelCount = flags & DdsMipMapCountFlag ? readUint32(data + 28) : 1;
+        std::uint32_t pixelFormatFlags = readUint32(data + 80);
+        std::uint32_t formatCode = readUint32(data + 84);
+        std::uint32_t caps2 = readUint32(data + 112);
+        if (width <= 0 || height <= 0)
+            return fail(name, "has no pixels");
+        if (caps2 != 0)
+            return fail(name, "is a cube map or volume texture, not supported");
+        if (!(pixelFormatFlags & DdsFourCCFlag))
+            return fail(name, "is not block compressed, not supported");
+
+        std::size_t offset = DdsHeaderEnd;
+        if (formatCode == fourCC('D', 'X', '1', '0'))
+        {
+            if (size < DdsDx10HeaderEnd)
+                return fail(name, "is cut short");
+            image.format = formatFromDxgi(readUint32(data + DdsHeaderEnd));
+            std::uint32_t dimension = readUint32(data + DdsHeaderEnd + 4);
+            std::uint32_t arraySize = readUint32(data + DdsHeaderEnd + 12);
+            if (dimension != 3 || arraySize > 1)    //3 is D3D10_RESOURCE_DIMENSION_TEXTURE2D
+                return fail(name, "is not a single 2D texture, not supported");
+            offset = DdsDx10HeaderEnd;
+        }
+        else if (formatCode == fourCC('D', 'X', 'T', '1'))
+            image.format = BC1;
+        else if (formatCode == fourCC('D', 'X', 'T', '5'))
+            image.format = BC3;
+        else if (formatCode == fourCC('A', 'T', 'I', '2') || formatCode == fourCC('B', 'C', '5', 'U'))
+            image.format = BC5;
+
+        if (blockBytes(image.format) == 0)
+            return fail(name, "is not BC1, BC3, BC5 or BC7, not supported");
+
+        //The levels follow each other with no padding
+        unsigned levels = clampLevelCount(levelCount, width, height);
+        for (unsigned level = 0; level < levels; level++)
+        {
+            GLsizei levelWidth = std::max(1, width >> level);
+            GLsizei levelHeight = std::max(1, height >> level);
+            std::size_t bytes = levelSize(image.format, levelWidth, levelHeight);
+            if (bytes > size - offset)
+                return fail(name, "is cut short");
+            image.levels.push_back(CompressedLevel{data + offset, bytes, levelWidth, levelHeight});
+            offset += bytes;
+        }
+        return true;
+    }
+
+    bool readKtx(const unsigned char *data, std::size_t size, CompressedImage &image, const std::string &name)
+    {
+        image = CompressedImage();
+        if (!isKtx(data, size) || size < KtxHeaderEnd)
+            return fail(name, "is not a KTX file");
+
+        std::uint32_t fields[13];
+        std::memcpy(fields, data + sizeof(KtxIdentifier), sizeof(fields));
+        if (fields[0] != KtxSameEndianness)
+            return fail(name, "has the other endianness, not supported");
+
+        std::uint32_t glType = fields[1];
+        image.format = static_cast<GLenum>(fields[4]);   //glInternalFormat
+        GLsizei width = static_cast<GLsizei>(fields[6]);
+        GLsizei height = static_cast<GLsizei>(fields[7]);
+        std::uint32_t depth = fields[8];
+        std::uint32_t arrayElements = fields[9];
+        std::uint32_t faces = fields[10];
+        std::uint32_t levelCount = fields[11];
+        std::uint32_t keyValueBytes = fields[12];
+
+        if (glType != 0 || blockBytes(image.format) == 0)
+            return fail(name, "is not BC1, BC3, BC5 or BC7, not supported");
+        if (width <= 0 || height <= 0)
+            return fail(name, "has no pixels");
+        if (depth != 0 || arrayElements != 0 || faces != 1)
+            return fail(name, "is not a single 2D texture, not supported");
+
+        //Each level is its size, then the data, padded to 4 bytes
+        std::size_t offset = KtxHeaderEnd;
+        if (keyValueBytes > size - offset)
+            return fail(name, "is cut short");
+        offset += keyValueBytes;
+
+        unsigned levels = clampLevelCount(levelCount, width, height);
+        for (unsigned level = 0; level < levels; level++)
+        {
+            if (size - offset < sizeof(std::uint32_t))
+                return fail(name, "is cut short");
+            std::size_t bytes = readUint32(data + offset);
+            offset += sizeof(std::uint32_t);
+
+            GLsizei levelWidth = std::max(1, width >> level);
+            GLsizei levelHeight = std::max(1, height >> level);
+            if (bytes != levelSize(image.format, levelWidth, levelHeight))
+                return fail(name, "has a mip level of the wrong size");
+            if (bytes > size - offset)
+                return fail(name, "is cut short");
+            image.levels.push_back(CompressedLevel{data + offset, bytes, levelWidth, levelHeight});
+            offset += (bytes + 3) / 4 * 4;
+            offset = std::min(offset, size);
+        }
+        return true;
+    }
+
+    bool readBitmap(const unsigned char *data, std::size_t size, BitmapImage &image, const std::string &name)
+    {
+        image = BitmapImage();
+        if (size < BitmapFileHeaderSize + sizeof(OBITMAPINFOHEADER) || data[0] != 'B' || data[1] != 'M')
+            return fail(name, "is not a bitmap");
+
+        //OBITMAPFILEHEADER has padding after bfType, so bfOffBits is copied on its own
+        OBITMAPFILEHEADER bmFileHeader;
+        std::memcpy(&bmFileHeader.bfOffBits, data + 10, sizeof(bmFileHeader.bfOffBits));
+        OBITMAPINFOHEADER bmInfoHeader;
+        std::memcpy(&bmInfoHeader, data + BitmapFileHeaderSize, sizeof(bmInfoHeader));
+
+        if (bmInfoHeader.biSize < sizeof(OBITMAPINFOHEADER))
+            return fail(name, "has an old OS/2 header, not supported");
+        if (bmInfoHeader.biBitCount != 24 && bmInfoHeader.biBitCount != 32)
+            return fail(name, "is not 24 or 32 bit, not supported");
+
+        //A negative height means the rows are stored top-down, else bottom-up like OpenGL wants them
+        image.topDown = bmInfoHeader.biHeight < 0;
+        image.width = bmInfoHeader.biWidth;
+        image.height = image.topDown ? -bmInfoHeader.biHeight : bmInfoHeader.biHeight;
+        int bytesPerPixel = bmInfoHeader.biBitCount / 8;
+        if (image.width <= 0 || image.height <= 0)
+            return fail(name, "has no pixels");
+
+        //Which byte of a 32 bit pixel each of red, green, blue and alpha is in, -1 for no alpha
+        int channelBytes[4] = {2, 1, 0, -1};
+        if (bmInfoHeader.biCompression == OBI_BITFIELDS || bmInfoHeader.biCompression == OBI_ALPHABITFIELDS)
+        {
+            if (bytesPerPixel != 4)
+                return fail(name, "has 24 bit channel masks, not supported");
+
+            //The masks are the end of the bigger headers, or follow the basic one
+            std::size_t maskCount = bmInfoHeader.biSize >= 56 || bmInfoHeader.biCompression == OBI_ALPHABITFIELDS ? 4 : 3;
+            ODWORD masks[4] = {0, 0, 0, 0};
+            if (BitmapFileHeaderSize + sizeof(OBITMAPINFOHEADER) + maskCount * sizeof(ODWORD) > size)
+                return fail(name, "is cut short");
+            std::memcpy(masks, data + BitmapFileHeaderSize + sizeof(OBITMAPINFOHEADER), maskCount * sizeof(ODWORD));
+
+            for (int channel = 0; channel < 4; channel++)
+            {
+                channelBytes[channel] = -1;
+                for (int byte = 0; byte < 4; byte++)
+                {
+                    if (masks[channel] == 0xFFu << (byte * 8))
+                        channelBytes[channel] = byte;
+                }
+                if (channelBytes[channel] < 0 && (channel < 3 || masks[channel] != 0))
+                    return fail(name, "has channels that are not whole bytes, not supported");
+            }
+            if ((masks[0] | masks[1] | masks[2] | masks[3]) != (masks[0] ^ masks[1] ^ masks[2] ^ masks[3]))
+                return fail(name, "has overlapping channel masks");
+        }
+        else if (bmInfoHeader.biCompression != OBI_RGB)
+        {
+            return fail(name, "is compressed, not supported");
+        }
+
+        //Rows are padded to 4 bytes, which is also the default GL_UNPACK_ALIGNMENT
+        image.rowSize = (static_cast<std::size_t>(image.width) * bmInfoHeader.biBitCount + 31) / 32 * 4;
+        std::size_t imageSize = image.rowSize * static_cast<std::size_t>(image.height);
+        if (bmFileHeader.bfOffBits > size || imageSize > size - bmFileHeader.bfOffBits)
+            return fail(name, "is cut short");
+        image.pixels = data + bmFileHeader.bfOffBits;
+
+        bool hasAlpha = channelBytes[3] >= 0;
+        image.internalFormat = hasAlpha ? GL_RGBA8 : GL_RGB8;
+        image.format = GL_BGR;
+        if (bytesPerPixel == 4)
+        {
+            //With no alpha the 4th byte is padding, and OpenGL drops it going to GL_RGB8
+            bool bgr = channelBytes[0] == 2 && channelBytes[1] == 1 && channelBytes[2] == 0;
+            bool rgb = channelBytes[0] == 0 && channelBytes[1] == 1 && channelBytes[2] == 2;
+            bool alphaLast = !hasAlpha || channelBytes[3] == 3;
+            if (bgr && alphaLast)
+            {
+                image.format = GL_BGRA;
+            }
+            else if (rgb && alphaLast)
+            {
+                image.format = GL_RGBA;
+            }
+            else
+            {
+                //Any other order is shuffled to RGBA. With no alpha the byte left over goes last.
+                int alphaByte = hasAlpha ? channelBytes[3] : 6 - channelBytes[0] - channelBytes[1] - channelBytes[2];
+                image.format = GL_RGBA;
+                image.shuffle = true;
+                image.order[0] = static_cast<unsigned char>(channelBytes[0]);
+                image.order[1] = static_cast<unsigned char>(channelBytes[1]);
+                image.order[2] = static_cast<unsigned char>(channelBytes[2]);
+                image.order[3] = static_cast<unsigned char>(alphaByte);
+            }
+        }
+        return true;
+    }
+
+    std::size_t bitmapSize(const BitmapImage &image)
+    {
+        return image.rowSize * static_cast<std::size_t>(image.height);
+    }
+
+    BitmapImage copyBitmap(const BitmapImage &image, unsigned char *out)
+    {
+        for (GLsizei row = 0; row < image.height; row++)
+        {
+            const unsigned char *source = image.pixels + static_cast<std::size_t>(row) * image.rowSize;
+            GLsizei targetRow = image.topDown ? image.height - 1 - row : row;
+            unsigned char *target = out + static_cast<std::size_t>(targetRow) * image.rowSize;
+            if (image.shuffle)
+                gsl::simd::shuffleBytes4(source, target, static_cast<std::size_t>(image.width), image.order);
+            else
+                std::memcpy(target, source, image.rowSize);
+        }
+
+        BitmapImage copy = image;
+        copy.pixels = out;
+        copy.topDown = false;
+        copy.shuffle = false;
+        return copy;
+    }
+
+} //namespace textureformat
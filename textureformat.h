@@ -0,0 +1,94 @@
+#ifndef TEXTUREFORMAT_H
+#define TEXTUREFORMAT_H
+
+#include <QOpenGLFunctions_4_1_Core>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//One mip level of a block compressed image, pointing into the file data
+struct CompressedLevel
+{
+    const unsigned char *data;
+    std::size_t size;
+    GLsizei width;
+    GLsizei height;
+};
+
+//A block compressed 2D texture with its mip chain, ready for glCompressedTexImage2D
+struct CompressedImage
+{
+    GLenum format{0};
+    std::vector<CompressedLevel> levels;    //level 0 is the full size
+};
+
+//An uncompressed bitmap, pointing into the file data
+struct BitmapImage
+{
+    const unsigned char *pixels{nullptr};
+    GLsizei width{0};
+    GLsizei height{0};
+    std::size_t rowSize{0};         //bytes per row, padded to 4 like GL_UNPACK_ALIGNMENT 4 wants
+    GLint internalFormat{GL_RGB8};
+    GLenum format{GL_BGR};          //the source format for glTexImage2D
+    bool topDown{false};            //the top row is first, OpenGL wants the bottom row first
+    bool shuffle{false};            //the channels are in an order OpenGL can't take - see copyBitmap()
+    unsigned char order[4]{0, 1, 2, 3};     //the byte of each of r, g, b and a when shuffle is set
+};
+
+/**
+ * Readers for bmp files, and for the DDS and KTX (version 1) containers with 2D textures in the BC formats below.
+ * Cube maps, arrays and volume textures are not supported.
+ *
+ * Nothing is copied - the images point into the data, which must stay alive until they are uploaded.
+ *
+ * DDS files store the top row first, KTX files the bottom row first like OpenGL.
+ * Export DDS files flipped vertically so they match the bitmaps.
+ */
+namespace textureformat
+{
+    //The block compressed formats, spelled out since not every gl.h has the extension names
+    constexpr GLenum BC1 = 0x83F1;          //GL_COMPRESSED_RGBA_S3TC_DXT1_EXT - rgb, 1 bit alpha
+    constexpr GLenum BC1_SRGB = 0x8C4D;     //GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    constexpr GLenum BC3 = 0x83F3;          //GL_COMPRESSED_RGBA_S3TC_DXT5_EXT - rgba
+    constexpr GLenum BC3_SRGB = 0x8C4F;     //GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    constexpr GLenum BC5 = 0x8DBD;          //GL_COMPRESSED_RG_RGTC2 - two channels, ex. normal maps
+    constexpr GLenum BC7 = 0x8E8C;          //GL_COMPRESSED_RGBA_BPTC_UNORM - high quality rgba
+    constexpr GLenum BC7_SRGB = 0x8E8D;     //GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+
+    //Bytes per 4x4 block: 8 for BC1, 16 for the others, 0 for formats not listed above
+    std::size_t blockBytes(GLenum format);
+
+    const char *formatName(GLenum format);
+
+    //True if data starts like a DDS or a KTX file
+    bool isDds(const unsigned char *data, std::size_t size);
+    bool isKtx(const unsigned char *data, std::size_t size);
+
+    /**
+     * Finds the format and mip levels of a DDS or KTX file in memory
+     * @param name Used in error messages
+     * @return false, with a message in the log, if the file is broken or not supported
+     */
+    bool readDds(const unsigned char *data, std::size_t size, CompressedImage &image, const std::string &name);
+    bool readKtx(const unsigned char *data, std::size_t size, CompressedImage &image, const std::string &name);
+
+    /**
+     * 24 bit bitmaps, and 32 bit ones with whole byte channels (BI_RGB or BI_BITFIELDS).
+     * Palette, 16 bit and compressed (RLE) bitmaps are not supported.
+     */
+    bool readBitmap(const unsigned char *data, std::size_t size, BitmapImage &image, const std::string &name);
+
+    //Bytes copyBitmap() writes
+    std::size_t bitmapSize(const BitmapImage &image);
+
+    /**
+     * Copies the pixels so glTexImage2D can take them in one call: bottom row first,
+     * and shuffled to GL_RGBA with gsl::simd::shuffleBytes4 if image.shuffle is set.
+     * @return The image as it is in out
+     */
+    BitmapImage copyBitmap(const BitmapImage &image, unsigned char *out);
+
+} //namespace textureformat
+
+#endif // TEXTUREFORMAT_H
@@ -1,6 +1,7 @@
 #include "innpch.h"
 #include "textureshader.h"
 #include "material.h"
+#include "texture.h"
 
 TextureShader::TextureShader(const std::string shaderName, const GLchar *geometryPath)
     :Shader(shaderName, geometryPath)
@@ -21,6 +22,12 @@ void TextureShader::transmitUniformData(gsl::Matrix4x4 *modelMatrix, Material *m
 {
     Shader::transmitUniformData(modelMatrix);
 
+    //Each material binds its own texture, so there is no limit on how many textures a scene has
+    if (material->mTexture)
+    {
+        glActiveTexture(GL_TEXTURE0 + material->mTextureUnit);
+        glBindTexture(GL_TEXTURE_2D, material->mTexture->id());
+    }
     glUniform1i(textureUniform, material->mTextureUnit); //TextureUnit = 0 as default);
     glUniform3f(objectColorUniform, material->mObjectColor.x, material->mObjectColor.y, material->mObjectColor.z);
 }
@@ -1,8 +1,6 @@
 #include "innpch.h"
 #include "vertex.h"
 
-Vertex::Vertex() { }
-
 Vertex::Vertex(float x, float y, float z, float r, float g, float b)
 {
     mXYZ.setX(x);
@@ -21,8 +19,6 @@ Vertex::Vertex(gsl::Vector3D a, gsl::Vector3D b , gsl::Vector2D c)
     mST = c;
 }
 
-Vertex::~Vertex() { }
-
 void Vertex::set_xyz(GLfloat *xyz)
 {
     mXYZ.setX(xyz[0]);
@@ -3,13 +3,13 @@
 
 #include "vector2d.h"
 #include "vector3d.h"
+#include <type_traits>
 
 class Vertex {
 public:
-    Vertex();
+    Vertex() = default;
     Vertex(float x, float y, float z, float r, float g, float b);
     Vertex(gsl::Vector3D a, gsl::Vector3D b, gsl::Vector2D c);
-    ~Vertex();
 
     //! Overloaded ostream operator which writes all vertex data on an open textfile stream
     friend std::ostream& operator<< (std::ostream&, const Vertex&);
@@ -29,10 +29,18 @@ public:
     void set_st(GLfloat s, GLfloat t);
     void set_uv(GLfloat u, GLfloat v);
 
+    const gsl::Vector3D &xyz() const { return mXYZ; }
+    const gsl::Vector3D &normal() const { return mNormal; }
+    const gsl::Vector2D &st() const { return mST; }
+
 private:
     gsl::Vector3D mXYZ;
     gsl::Vector3D mNormal;
     gsl::Vector2D mST;
 };
 
+//Vertex arrays are copied and uploaded to OpenGL as raw memory
+static_assert(std::is_trivially_copyable<Vertex>::value, "Vertex must be trivially copyable");
+static_assert(sizeof(Vertex) == 8 * sizeof(GLfloat), "Vertex must be 8 packed floats");
+
 #endif // VERTEX_H
@@ -0,0 +1,183 @@
+#include "innpch.h"
+#include "vertexformat.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace vertexformat
+{
+    namespace
+    {
+        //Normalized values are packed as round(value * max), the conversion of OpenGL 4.2 and later.
+        //Drivers following the older 4.1 rule, (2c + 1) / (2^b - 1), are off by half a step at most.
+        inline std::int32_t toSignedNormalized(GLfloat value, std::int32_t max)
+        {
+            value = std::max(-1.f, std::min(1.f, value));
+            return static_cast<std::int32_t>(std::lround(value * static_cast<GLfloat>(max)));
+        }
+    }
+
+    GLushort floatToHalf(GLfloat value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        std::uint32_t sign = (bits >> 16) & 0x8000u;
+        std::uint32_t exponent = (bits >> 23) & 0xFFu;
+        std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (exponent == 0xFFu)      //infinity, or NaN (keeps a mantissa bit so it stays NaN)
+            return static_cast<GLushort>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+        std::int32_t halfExponent = static_cast<std::int32_t>(exponent) - 127 + 15;
+        if (halfExponent >= 31)     //too large
+            return static_cast<GLushort>(sign | 0x7C00u);
+
+        if (halfExponent <= 0)
+        {
+            //Subnormal half, or zero if too small
+            if (halfExponent < -10)
+                return static_cast<GLushort>(sign);
+            mantissa |= 0x800000u;  //the implicit 1
+            std::uint32_t shift = static_cast<std::uint32_t>(14 - halfExponent);
+            std::uint32_t half = mantissa >> shift;
+            std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            std::uint32_t halfway = 1u << (shift - 1u);
+            if (remainder > halfway || (remainder == halfway && (half & 1u)))
+                ++half;
+            return static_cast<GLushort>(sign | half);
+        }
+
+        std::uint32_t half = (static_cast<std::uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+        std::uint32_t remainder = mantissa & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+            ++half;     //may carry into the exponent, which rounds up to the next power of two or infinity
+        return static_cast<GLushort>(sign | half);
+    }
+
+    GLfloat halfToFloat(GLushort half)
+    {
+        std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+        std::uint32_t exponent = (half >> 10) & 0x1Fu;
+        std::uint32_t mantissa = half & 0x3FFu;
+
+        std::uint32_t bits;
+        if (exponent == 0x1Fu)
+        {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        }
+        else if (exponent == 0)
+        {
+            //Subnormal: exactly mantissa * 2^-24
+            GLfloat value = static_cast<GLfloat>(mantissa) * (1.f / 16777216.f);
+            return sign ? -value : value;
+        }
+        else
+        {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+        GLfloat value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    GLuint packNormal(const gsl::Vector3D &normal)
+    {
+        auto component = [](GLfloat value) {
+            return static_cast<GLuint>(toSignedNormalized(value, 511)) & 0x3FFu;
+        };
+        //w is 1, like the default OpenGL fills in for the 3 component Float layout,
+        //since attribute 1 is read with 4 components here
+        return component(normal.x) | (component(normal.y) << 10) | (component(normal.z) << 20) | (1u << 30);
+    }
+
+    PackedMesh pack(const Vertex *vertices, std::size_t count)
+    {
+        PackedMesh mesh;
+        if (count == 0)
+            return mesh;
+
+        gsl::Vector3D min = vertices[0].xyz();
+        gsl::Vector3D max = min;
+        for (std::size_t i = 1; i < count; i++)
+        {
+            const gsl::Vector3D &position = vertices[i].xyz();
+            min = gsl::Vector3D(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+            max = gsl::Vector3D(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+        }
+        gsl::Vector3D center = (min + max) * 0.5f;
+        gsl::Vector3D halfSize = (max - min) * 0.5f;
+
+        //A flat side (ex. the height of a plane) has no size - everything packs to 0 there
+        auto inverse = [](GLfloat size) { return size > 0.f ? 1.f / size : 0.f; };
+        gsl::Vector3D inverseHalfSize(inverse(halfSize.x), inverse(halfSize.y), inverse(halfSize.z));
+
+        mesh.mVertices.resize(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const Vertex &vertex = vertices[i];
+            PackedVertex &packed = mesh.mVertices[i];
+            gsl::Vector3D position = vertex.xyz() - center;
+            packed.mPosition[0] = static_cast<GLshort>(toSignedNormalized(position.x * inverseHalfSize.x, 32767));
+            packed.mPosition[1] = static_cast<GLshort>(toSignedNormalized(position.y * inverseHalfSize.y, 32767));
+            packed.mPosition[2] = static_cast<GLshort>(toSignedNormalized(position.z * inverseHalfSize.z, 32767));
+            packed.mPosition[3] = 0;
+            packed.mNormal = packNormal(vertex.normal());
+            packed.mUV[0] = floatToHalf(vertex.st().x);
+            packed.mUV[1] = floatToHalf(vertex.st().y);
+        }
+
+        mesh.mPositionTransform.setToIdentity();
+        mesh.mPositionTransform.translate(center);
+        mesh.mPositionTransform.scale(halfSize);
+        return mesh;
+    }
+
+    void setVertexAttributes(QOpenGLFunctions_4_1_Core &gl, VertexLayout layout)
+    {
+        if (layout == VertexLayout::Packed)
+        {
+            // 1rst attribute buffer : vertices
+            gl.glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, mPosition));
+            gl.glEnableVertexAttribArray(0);
+
+            // 2nd attribute buffer : colors
+            gl.glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, mNormal));
+            gl.glEnableVertexAttribArray(1);
+
+            // 3rd attribute buffer : uvs
+            gl.glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (GLvoid*)offsetof(PackedVertex, mUV));
+            gl.glEnableVertexAttribArray(2);
+            return;
+        }
+
+        // 1rst attribute buffer : vertices
+        gl.glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)0);
+        gl.glEnableVertexAttribArray(0);
+
+        // 2nd attribute buffer : colors
+        gl.glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(3 * sizeof(GLfloat)));
+        gl.glEnableVertexAttribArray(1);
+
+        // 3rd attribute buffer : uvs
+        gl.glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)(6 * sizeof(GLfloat)));
+        gl.glEnableVertexAttribArray(2);
+    }
+
+    GLenum uploadIndices(QOpenGLFunctions_4_1_Core &gl, const GLuint *indices, std::size_t indexCount,
+                         std::size_t vertexCount)
+    {
+        if (vertexCount <= std::numeric_limits<GLushort>::max())
+        {
+            std::vector<GLushort> shortIndices(indices, indices + indexCount);
+            gl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexCount * sizeof(GLushort)),
+                            shortIndices.data(), GL_STATIC_DRAW);
+            return GL_UNSIGNED_SHORT;
+        }
+        gl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexCount * sizeof(GLuint)),
+                        indices, GL_STATIC_DRAW);
+        return GL_UNSIGNED_INT;
+    }
+
+} //namespace vertexformat
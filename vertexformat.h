@@ -0,0 +1,65 @@
+#ifndef VERTEXFORMAT_H
+#define VERTEXFORMAT_H
+
+#include <QOpenGLFunctions_4_1_Core>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "vertex.h"
+#include "matrix4x4.h"
+
+//How the vertices of a mesh are stored in its vertex buffer
+enum class VertexLayout
+{
+    Float,      //Vertex as it is, 32 bytes
+    Packed      //PackedVertex, 16 bytes
+};
+
+/**
+ * Vertex packed to half the size of Vertex, for meshes that don't need full float precision.
+ * Attribute locations are the same as for Vertex, so the shaders don't change:
+ * 0 - position as normalized shorts, in [-1, 1] across the bounding box of the mesh.
+ *     The model matrix must be multiplied with PackedMesh::mPositionTransform to get the real positions.
+ * 1 - normal as GL_INT_2_10_10_10_REV, normalized, with w = 1 like the Float layout gets
+ * 2 - uv as half floats
+ */
+struct PackedVertex
+{
+    GLshort mPosition[4];   //the 4th is padding, so the normal is 4 byte aligned
+    GLuint mNormal;
+    GLushort mUV[2];
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must be 16 bytes");
+static_assert(std::is_trivially_copyable<PackedVertex>::value, "PackedVertex must be trivially copyable");
+
+struct PackedMesh
+{
+    std::vector<PackedVertex> mVertices;
+    gsl::Matrix4x4 mPositionTransform;  //from the packed positions to mesh space
+};
+
+namespace vertexformat
+{
+    //IEEE 754 half precision, rounded to nearest even. Too large values become infinity.
+    GLushort floatToHalf(GLfloat value);
+    GLfloat halfToFloat(GLushort half);
+
+    //Signed normalized, for the GL_INT_2_10_10_10_REV format. Components are clamped to [-1, 1], w is 1.
+    GLuint packNormal(const gsl::Vector3D &normal);
+
+    PackedMesh pack(const Vertex *vertices, std::size_t count);
+
+    //Sets up attributes 0, 1 and 2 for the vertex buffer bound to GL_ARRAY_BUFFER
+    void setVertexAttributes(QOpenGLFunctions_4_1_Core &gl, VertexLayout layout);
+
+    /**
+     * Uploads the indices to the buffer bound to GL_ELEMENT_ARRAY_BUFFER, as 16 bit
+     * indices if all the vertices can be reached with them.
+     * @return The index type to give glDrawElements, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+     */
+    GLenum uploadIndices(QOpenGLFunctions_4_1_Core &gl, const GLuint *indices, std::size_t indexCount,
+                         std::size_t vertexCount);
+
+} //namespace vertexformat
+
+#endif // VERTEXFORMAT_H
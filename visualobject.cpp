@@ -20,3 +20,53 @@ void VisualObject::setShader(Shader *shader)
 {
     mMaterial.mShader = shader;
 }
+
+void VisualObject::geometryUploaded()
+{
+    mIndexCount = static_cast<GLsizei>(mIndices.size());
+    if (mResidency != Residency::KeepCpuCopy)
+    {
+        //swap with empty vectors, clear() would keep the memory
+        std::vector<Vertex>().swap(mVertices);
+        std::vector<GLuint>().swap(mIndices);
+    }
+}
+
+std::size_t VisualObject::cpuGeometryBytes() const
+{
+    return mVertices.capacity() * sizeof(Vertex) + mIndices.capacity() * sizeof(GLuint);
+}
+
+void VisualObject::setMatrix(const gsl::Matrix4x4 &matrix)
+{
+    mMatrix = matrix;
+    matrixChanged();
+}
+
+void VisualObject::matrixChanged()
+{
+    mInverseDirty = true;
+    mWorldBoundsDirty = true;
+}
+
+const gsl::Matrix4x4 &VisualObject::inverseMatrix()
+{
+    if (mInverseDirty)
+    {
+        mInverseMatrix = mMatrix;
+        mInverseMatrix.inverse();
+        mInverseDirty = false;
+    }
+    return mInverseMatrix;
+}
+
+const Bounds &VisualObject::worldBounds()
+{
+    //Empty local bounds may be a mesh that is still loading, so try again next time
+    if (mWorldBoundsDirty || mWorldBounds.isEmpty())
+    {
+        mWorldBounds = localBounds().transformed(mMatrix);
+        mWorldBoundsDirty = false;
+    }
+    return mWorldBounds;
+}
@@ -4,6 +4,8 @@
 #include <QOpenGLFunctions_4_1_Core>
 #include <vector>
 #include "vertex.h"
+#include "bounds.h"
+#include "meshdata.h"
 #include "matrix4x4.h"
 #include "material.h"
 #include "shader.h"
@@ -17,7 +19,19 @@ public:
     virtual void init();
     virtual void draw()=0;
 
-    gsl::Matrix4x4 mMatrix;
+    const gsl::Matrix4x4 &matrix() const { return mMatrix; }
+
+    //Also marks the inverse and the world bounds for recalculation
+    void setMatrix(const gsl::Matrix4x4 &matrix);
+
+    //Inverse of mMatrix, only recalculated after matrixChanged()
+    const gsl::Matrix4x4 &inverseMatrix();
+
+    //Bounds of the vertices, in object space. Empty if the object has no vertices (yet).
+    virtual const Bounds &localBounds() const { return mLocalBounds; }
+
+    //localBounds() transformed by mMatrix, only recalculated after matrixChanged()
+    const Bounds &worldBounds();
 
     void setShader(Shader *shader);
 
@@ -27,13 +41,41 @@ public:
 
     Material mMaterial;
 
+    //For objects that make their own vertices. ReloadOnDemand works like DropAfterUpload,
+    //as there is no file to reload from.
+    Residency mResidency{Residency::DropAfterUpload};
+
+    //Bytes held in mVertices and mIndices
+    std::size_t cpuGeometryBytes() const;
+
 protected:
-    std::vector<Vertex> mVertices;   //This is usually not needed after object is made
-    std::vector<GLuint> mIndices;    //This is usually not needed after object is made
+    //Model matrix. Subclasses that change it directly must call matrixChanged() afterwards,
+    //or inverseMatrix() and worldBounds() keep returning the old values. Others use setMatrix().
+    gsl::Matrix4x4 mMatrix;
+
+    //Call after changing mMatrix, so data cached from it is recalculated
+    void matrixChanged();
+
+    //Call at the end of init(), when the buffers are made.
+    //Frees mVertices and mIndices, unless mResidency is KeepCpuCopy.
+    void geometryUploaded();
+
+    std::vector<Vertex> mVertices;   //Freed by geometryUploaded(), depending on mResidency
+    std::vector<GLuint> mIndices;    //Freed by geometryUploaded(), depending on mResidency
+    GLsizei mIndexCount{0};          //Indices in mEAB, valid after geometryUploaded()
 
     GLuint mVAO{0};
     GLuint mVBO{0};
     GLuint mEAB{0}; //holds the indices (Element Array Buffer - EAB)
+    GLenum mIndexType{GL_UNSIGNED_INT}; //type of the indices in mEAB, for glDrawElements
+
+    Bounds mLocalBounds;    //set by objects that make their own vertices
+
+    gsl::Matrix4x4 mInverseMatrix;
+    bool mInverseDirty{true};
+
+    Bounds mWorldBounds;
+    bool mWorldBoundsDirty{true};
 
 };
 #endif // VISUALOBJECT_H